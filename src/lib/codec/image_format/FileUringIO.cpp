@@ -0,0 +1,311 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ */
+
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#include "FileUringIO.h"
+#include "common.h"
+
+#define IO_MAX 2147483647U
+
+FileUringIO::FileUringIO()
+    : ringInitialized_(false), fd_(-1), ownsDescriptor_(false), seekable_(false), error_(false),
+      numQueued_(0), numPending_(0), reclaim_callback_(nullptr), reclaim_user_data_(nullptr)
+{
+  memset(&ring_, 0, sizeof(ring_));
+}
+FileUringIO::~FileUringIO()
+{
+  close();
+}
+void FileUringIO::registerGrkReclaimCallback(grk_io_callback reclaim_callback, void* user_data)
+{
+  reclaim_callback_ = reclaim_callback;
+  reclaim_user_data_ = user_data;
+}
+bool FileUringIO::attach(const std::string& fileName, const std::string& mode, int fd)
+{
+  if(fd < 0)
+    return false;
+  fileName_ = fileName;
+  fd_ = fd;
+  ownsDescriptor_ = false;
+  error_ = false;
+  // positional writes require a seekable file: pipes and terminals are written in order
+  seekable_ = lseek(fd_, 0, SEEK_CUR) != (off_t)-1;
+  if(mode[0] == 'r' || !seekable_)
+    return true;
+  int rc = io_uring_queue_init(queueDepth, &ring_, 0);
+  if(rc < 0)
+  {
+    spdlog::warn("{}: io_uring not available ({}), falling back to synchronous writes", fileName,
+                 strerror(-rc));
+    return true;
+  }
+  ringInitialized_ = true;
+
+  return true;
+}
+bool FileUringIO::open(const std::string& fileName, const std::string& mode)
+{
+  bool useStdio = grk::useStdio(fileName);
+  bool doRead = mode[0] == 'r';
+  int fd = 0;
+  if(useStdio)
+  {
+    fd = doRead ? STDIN_FILENO : STDOUT_FILENO;
+  }
+  else
+  {
+    fd = ::open(fileName.c_str(), doRead ? O_RDONLY : (O_WRONLY | O_CREAT | O_TRUNC), 0666);
+    if(fd < 0)
+    {
+      spdlog::error("{}: {}", fileName, strerror(errno));
+      return false;
+    }
+  }
+  if(!attach(fileName, mode, fd))
+  {
+    if(!useStdio)
+      ::close(fd);
+    return false;
+  }
+  ownsDescriptor_ = !useStdio;
+
+  return true;
+}
+bool FileUringIO::close(void)
+{
+  bool rc = !error_;
+  if(ringInitialized_)
+  {
+    // drain all outstanding requests before tearing down the ring
+    while(numPending_)
+    {
+      if(!submit() || !retrieveCompletions(true))
+      {
+        rc = false;
+        break;
+      }
+    }
+    io_uring_queue_exit(&ring_);
+    ringInitialized_ = false;
+    numQueued_ = 0;
+    numPending_ = 0;
+  }
+  if(ownsDescriptor_ && fd_ >= 0)
+    rc = (::close(fd_) == 0) && rc;
+  fd_ = -1;
+  ownsDescriptor_ = false;
+
+  return rc;
+}
+uint64_t FileUringIO::write(uint8_t* buf, uint64_t offset, size_t len, size_t maxLen, bool pooled)
+{
+  return write(GrkIOBuf(buf, offset, len, maxLen, pooled));
+}
+uint64_t FileUringIO::write(GrkIOBuf buffer)
+{
+  if(!buffer.len || !buffer.data)
+  {
+    if(buffer.pooled)
+      reclaim(buffer);
+    return 0;
+  }
+  if(!ringInitialized_)
+  {
+    bool rc = writeSynch(buffer);
+    if(buffer.pooled)
+      reclaim(buffer);
+    return rc ? buffer.len : 0;
+  }
+  // caller may reuse a non-pooled buffer as soon as we return, so we write a copy,
+  // which is freed on completion
+  if(!buffer.pooled)
+  {
+    GrkIOBuf copy;
+    if(!copy.alloc(buffer.len))
+      return 0;
+    memcpy(copy.data, buffer.data, buffer.len);
+    copy.offset = buffer.offset;
+    buffer = copy;
+  }
+  // bound the number of buffers held by the ring
+  while(numPending_ >= queueDepth)
+  {
+    if(!submit() || !retrieveCompletions(true))
+    {
+      reclaim(buffer);
+      return 0;
+    }
+  }
+  auto req = new UringRequest(buffer);
+  if(!enqueue(req))
+  {
+    reclaim(buffer);
+    delete req;
+    return 0;
+  }
+  // hand back buffers whose writes have already completed
+  if(!retrieveCompletions(false))
+    return 0;
+
+  return buffer.len;
+}
+bool FileUringIO::enqueue(UringRequest* req)
+{
+  auto sqe = io_uring_get_sqe(&ring_);
+  if(!sqe)
+  {
+    // submission queue is full
+    if(!submit())
+      return false;
+    sqe = io_uring_get_sqe(&ring_);
+    if(!sqe)
+      return false;
+  }
+  size_t ioSize = std::min<size_t>(req->buf.len - req->written, IO_MAX);
+  io_uring_prep_write(sqe, fd_, req->buf.data + req->written, (unsigned)ioSize,
+                      req->buf.offset + req->written);
+  io_uring_sqe_set_data(sqe, req);
+  numQueued_++;
+  numPending_++;
+  // a failed submission is reported by close
+  if(numQueued_ >= submitBatch)
+    submit();
+
+  return true;
+}
+bool FileUringIO::submit(void)
+{
+  if(!numQueued_)
+    return true;
+  int rc = io_uring_submit(&ring_);
+  if(rc < 0)
+  {
+    spdlog::error("{}: io_uring submit failed: {}", fileName_, strerror(-rc));
+    error_ = true;
+    return false;
+  }
+  numQueued_ -= std::min<uint32_t>((uint32_t)rc, numQueued_);
+
+  return true;
+}
+bool FileUringIO::retrieveCompletions(bool wait)
+{
+  bool success = true;
+  while(numPending_ > numQueued_)
+  {
+    io_uring_cqe* cqe = nullptr;
+    int rc = wait ? io_uring_wait_cqe(&ring_, &cqe) : io_uring_peek_cqe(&ring_, &cqe);
+    if(rc == -EAGAIN)
+      break;
+    if(rc == -EINTR)
+      continue;
+    if(rc < 0)
+    {
+      spdlog::error("{}: io_uring completion failed: {}", fileName_, strerror(-rc));
+      error_ = true;
+      return false;
+    }
+    // only block for the first completion
+    wait = false;
+    auto req = (UringRequest*)io_uring_cqe_get_data(cqe);
+    int res = cqe->res;
+    io_uring_cqe_seen(&ring_, cqe);
+    numPending_--;
+    if(res <= 0)
+    {
+      spdlog::error("{}: io_uring write failed: {}", fileName_,
+                    res < 0 ? strerror(-res) : "no bytes written");
+      error_ = true;
+      success = false;
+    }
+    else
+    {
+      req->written += (size_t)res;
+      // resubmit remainder of short write
+      if(req->written < req->buf.len)
+      {
+        if(enqueue(req))
+          continue;
+        error_ = true;
+        success = false;
+      }
+    }
+    reclaim(req->buf);
+    delete req;
+  }
+
+  return success;
+}
+bool FileUringIO::writeSynch(GrkIOBuf buffer)
+{
+  size_t written = 0;
+  while(written < buffer.len)
+  {
+    size_t ioSize = std::min<size_t>(buffer.len - written, IO_MAX);
+    ssize_t count =
+        seekable_ ? pwrite(fd_, buffer.data + written, ioSize, (off_t)(buffer.offset + written))
+                  : ::write(fd_, buffer.data + written, ioSize);
+    if(count < 0 && errno == EINTR)
+      continue;
+    if(count <= 0)
+    {
+      spdlog::error("{}: write failed: {}", fileName_,
+                    count < 0 ? strerror(errno) : "no bytes written");
+      error_ = true;
+      return false;
+    }
+    written += (size_t)count;
+  }
+
+  return true;
+}
+void FileUringIO::reclaim(GrkIOBuf buffer)
+{
+  if(buffer.pooled && reclaim_callback_)
+    reclaim_callback_(0, buffer, reclaim_user_data_);
+  else
+    buffer.dealloc();
+}
+bool FileUringIO::read(uint8_t* buf, size_t len)
+{
+  size_t total = 0;
+  while(total < len)
+  {
+    ssize_t count = ::read(fd_, buf + total, len - total);
+    if(count < 0 && errno == EINTR)
+      continue;
+    if(count <= 0)
+      break;
+    total += (size_t)count;
+  }
+  if(total < len)
+    spdlog::error("read fewer bytes {} than expected number of bytes {}.", total, len);
+
+  return total == len;
+}
+uint64_t FileUringIO::seek(int64_t off, int whence)
+{
+  return lseek(fd_, (off_t)off, whence) == (off_t)-1 ? (uint64_t)-1 : 0;
+}
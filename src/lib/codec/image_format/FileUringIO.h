@@ -0,0 +1,82 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ */
+
+
+#pragma once
+
+#include "IFileIO.h"
+
+#include <liburing.h>
+
+/**
+ * Asynchronous file writer backed by io_uring.
+ *
+ * Writes are positional, and are submitted to the ring in batches. Buffers are
+ * released as their writes complete: pooled buffers are handed back through the
+ * registered reclaim callback, and are otherwise freed. Non-pooled buffers are copied,
+ * since callers may reuse them as soon as write returns.
+ *
+ * If io_uring is not available, or the file is not seekable, all writes
+ * fall back to blocking writes.
+ */
+class FileUringIO : public IFileIO
+{
+public:
+  FileUringIO();
+  virtual ~FileUringIO();
+  void registerGrkReclaimCallback(grk_io_callback reclaim_callback, void* user_data);
+  bool attach(const std::string& fileName, const std::string& mode, int fd);
+  bool open(const std::string& fileName, const std::string& mode) override;
+  bool close(void) override;
+  uint64_t write(uint8_t* buf, uint64_t offset, size_t len, size_t maxLen, bool pooled) override;
+  uint64_t write(GrkIOBuf buffer) override;
+  bool read(uint8_t* buf, size_t len) override;
+  uint64_t seek(int64_t off, int whence) override;
+
+private:
+  struct UringRequest
+  {
+    explicit UringRequest(GrkIOBuf buffer) : buf(buffer), written(0) {}
+    GrkIOBuf buf;
+    size_t written;
+  };
+  bool enqueue(UringRequest* req);
+  bool submit(void);
+  bool retrieveCompletions(bool wait);
+  bool writeSynch(GrkIOBuf buffer);
+  void reclaim(GrkIOBuf buffer);
+
+  io_uring ring_;
+  bool ringInitialized_;
+  int fd_;
+  bool ownsDescriptor_;
+  bool seekable_;
+  bool error_;
+  std::string fileName_;
+  // requests prepared but not yet submitted
+  uint32_t numQueued_;
+  // requests prepared but not yet completed
+  uint32_t numPending_;
+  grk_io_callback reclaim_callback_;
+  void* reclaim_user_data_;
+
+  // maximum number of requests in flight
+  static constexpr uint32_t queueDepth = 64;
+  // number of prepared requests that triggers a submission
+  static constexpr uint32_t submitBatch = 8;
+};
@@ -55,13 +55,11 @@ void ImageFormat::ioReclaimBuffer(uint32_t threadId, grk_io_buf buffer)
   if(cb)
     cb(threadId, buffer, serializer.getIOReclaimUserData());
 }
-#ifndef GROK_HAVE_URING
 void ImageFormat::reclaim(uint32_t threadId, grk_io_buf pixels)
 {
   // for synchronous encode, we immediately return the pixel buffer to the pool
   ioReclaimBuffer(threadId, GrkIOBuf(pixels));
 }
-#endif
 bool ImageFormat::encodeInit(grk_image* image, const std::string& filename,
                              uint32_t compression_level, [[maybe_unused]] uint32_t concurrency)
 {
@@ -91,16 +89,24 @@ bool ImageFormat::encodePixels(uint32_t threadId, grk_io_buf pixels)
 bool ImageFormat::encodePixelsCore([[maybe_unused]] uint32_t threadId, grk_io_buf pixels)
 {
 #ifdef GROK_HAVE_URING
-  serializer.initPooledRequest();
+  serializer.initPooledRequest(pixels);
 #endif
   bool success = encodePixelsCoreWrite(pixels);
+#ifdef GROK_HAVE_URING
+  // pixels scheduled with uring are reclaimed when their write completes
+  bool scheduled = false;
+  success = serializer.completePooledRequest(&scheduled) && success;
+#else
+  bool scheduled = false;
+#endif
   if(success)
   {
-#ifndef GROK_HAVE_URING
-    serializer.incrementPooled();
-    // for synchronous encode, we immediately return the pixel buffer to the pool
-    reclaim(threadId, GrkIOBuf(pixels));
-#endif
+    if(!scheduled)
+    {
+      serializer.incrementPooled();
+      // for synchronous encode, we immediately return the pixel buffer to the pool
+      reclaim(threadId, GrkIOBuf(pixels));
+    }
     if(serializer.allPooledRequestsComplete())
       encodeFinish();
   }
@@ -9,6 +9,9 @@
 Serializer::Serializer(void)
     :
 #ifndef _WIN32
+#ifdef GROK_HAVE_URING
+      pooledActive_(false), pooledScheduled_(false), end_(0),
+#endif
       fd_(-1),
 #endif
       numPooledRequests_(0), max_pooled_requests_(0), asynchActive_(false), off_(0),
@@ -111,11 +114,12 @@ bool Serializer::open(const std::string& name, const std::string& mode,
     }
   }
 #ifdef GROK_HAVE_URING
-  if(asynch)
+  if(asynch && !doRead)
   {
     if(!uring.attach(name, mode, fd))
       return false;
     asynchActive_ = true;
+    end_ = 0;
   }
 #endif
   fd_ = fd;
@@ -126,18 +130,46 @@ bool Serializer::open(const std::string& name, const std::string& mode,
 }
 bool Serializer::close(void)
 {
+  bool success = true;
+#ifdef GROK_HAVE_URING
+  if(asynchActive_)
+  {
+    asynchActive_ = false;
+    success = scheduleDeferredWrite(false);
+    success = uring.close() && success;
+  }
+#endif
   if(fd_ < 0)
-    return true;
+    return success;
 
   int rc = ::close(fd_);
   fd_ = -1;
 
-  return rc == 0;
+  return success && rc == 0;
 }
 uint64_t Serializer::seek(int64_t off, int32_t whence)
 {
+#ifdef GROK_HAVE_URING
+  // asynchronous writes are positional, so seek only moves the write offset
   if(asynchActive_)
+  {
+    switch(whence)
+    {
+      case SEEK_SET:
+        off_ = (uint64_t)off;
+        break;
+      case SEEK_CUR:
+        off_ = (uint64_t)((int64_t)off_ + off);
+        break;
+      case SEEK_END:
+        off_ = (uint64_t)((int64_t)end_ + off);
+        break;
+      default:
+        return (uint64_t)-1;
+    }
     return off_;
+  }
+#endif
   off_t rc = lseek(getFd(), off, whence);
   if(rc == (off_t)-1)
   {
@@ -147,6 +179,7 @@ uint64_t Serializer::seek(int64_t off, int32_t whence)
       spdlog::error("I/O error");
     return (uint64_t)-1;
   }
+  off_ = (uint64_t)rc;
 
   return (uint64_t)rc;
 }
@@ -156,25 +189,23 @@ size_t Serializer::write(uint8_t* buf, size_t bytes_total)
   // asynchronous write
   if(asynchActive_)
   {
-    // 1. schedule buffer
-    scheduled_.data_ = buf;
-    scheduled_.len_ = bytes_total;
-    scheduled_.offset_ = off_;
-    uring.write(scheduled_);
-    off_ += scheduled_.len_;
-    // 2. close uring if this is final buffer to schedule
-    if(scheduled_.pooled_ && (++numPooledRequests_ == max_pooled_requests_))
+    // writes are scheduled in order, so a deferred write is scheduled first
+    if(!scheduleDeferredWrite(false))
+      return 0;
+    GrkIOBuf scheduled(buf, off_, bytes_total, bytes_total, false);
+    off_ += bytes_total;
+    end_ = std::max(end_, off_);
+    // a write from pooled pixels is deferred, since only the final write
+    // from the pixels may hand them over to the ring
+    if(pooledActive_ && buf >= pooled_.data &&
+       buf + bytes_total <= pooled_.data + pooled_.alloc_len)
     {
-      asynchActive_ = false;
-      [[maybe_unused]] bool rc = uring.close();
-      // todo: handle return value
-      assert(rc);
-      close();
-      // todo: re-open in buffered mode
-      open(filename_, "a", false);
+      deferred_ = scheduled;
+      return bytes_total;
     }
-    // 3. clear scheduled
-    scheduled_ = GrkIOBuf();
+    // other buffers, such as headers, are copied by the ring
+    if(uring.write(scheduled) != bytes_total)
+      return 0;
 
     return bytes_total;
   }
@@ -199,17 +230,56 @@ size_t Serializer::write(uint8_t* buf, size_t bytes_total)
 #endif // #ifndef _WIN32
 
 #ifdef GROK_HAVE_URING
-void Serializer::initPooledRequest(void)
+void Serializer::initPooledRequest(grk_io_buf pixels)
 {
-  scheduled_.pooled_ = true;
+  pooled_ = GrkIOBuf(pixels);
+  pooledActive_ = asynchActive_;
+  pooledScheduled_ = false;
 }
-#else
+bool Serializer::scheduleDeferredWrite(bool final)
+{
+  if(!deferred_.data)
+    return true;
+  auto scheduled = deferred_;
+  deferred_ = GrkIOBuf();
+  // pooled pixels are handed over to the ring by the final write of a pooled request,
+  // and reclaimed when that write completes. Earlier writes are copied by the ring
+  if(final && scheduled.data == pooled_.data)
+  {
+    auto offset = scheduled.offset;
+    auto len = scheduled.len;
+    scheduled = pooled_;
+    scheduled.offset = offset;
+    scheduled.len = len;
+    scheduled.pooled = true;
+    pooledScheduled_ = true;
+  }
+
+  return uring.write(scheduled) == scheduled.len;
+}
+bool Serializer::completePooledRequest(bool* scheduled)
+{
+  pooledActive_ = false;
+  bool rc = scheduleDeferredWrite(true);
+  *scheduled = pooledScheduled_;
+  // close uring once the final pooled request is scheduled, and resume
+  // synchronous writes from the current offset
+  if(pooledScheduled_ && (++numPooledRequests_ == max_pooled_requests_))
+  {
+    asynchActive_ = false;
+    rc = uring.close() && rc;
+    rc = rc && lseek(fd_, (off_t)off_, SEEK_SET) != (off_t)-1;
+  }
+
+  return rc;
+}
+#endif
 void Serializer::incrementPooled(void)
 {
-  // write method will take care of incrementing numPixelRequests if uring is enabled
+  // write method will take care of incrementing numPixelRequests
+  // for pixels scheduled with uring
   numPooledRequests_++;
 }
-#endif
 uint32_t Serializer::getNumPooledRequests(void)
 {
   return numPooledRequests_;
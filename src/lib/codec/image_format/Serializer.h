@@ -29,17 +29,38 @@ struct Serializer
   uint32_t getNumPooledRequests(void);
   uint64_t getOffset(void);
 #ifdef GROK_HAVE_URING
-  void initPooledRequest(void);
-#else
-  void incrementPooled(void);
+  /**
+   * Begins a pooled request: if the final write from the pixels starts at the beginning
+   * of the pixel buffer, the pixels are handed over to the ring, and reclaimed when that
+   * write completes
+   */
+  void initPooledRequest(grk_io_buf pixels);
+  /**
+   * Ends a pooled request
+   * @param scheduled set to true if pixels were handed over to the ring
+   * @return true if successful
+   */
+  bool completePooledRequest(bool* scheduled);
 #endif
+  void incrementPooled(void);
   bool allPooledRequestsComplete(void);
 
 private:
 #ifndef _WIN32
 #ifdef GROK_HAVE_URING
   FileUringIO uring;
-  GrkIOBuf scheduled_;
+  /**
+   * Schedules deferred write from pooled pixels
+   * @param final true if this is the final write of the pooled request
+   */
+  bool scheduleDeferredWrite(bool final);
+  GrkIOBuf pooled_;
+  // last write from pooled pixels, not yet scheduled
+  GrkIOBuf deferred_;
+  bool pooledActive_;
+  bool pooledScheduled_;
+  // end of written data, for SEEK_END while writes are in flight
+  uint64_t end_;
 #endif
   int getMode(std::string mode);
   int fd_;
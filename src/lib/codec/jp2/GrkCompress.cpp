@@ -625,6 +625,12 @@ static void compress_help_display(void)
           "Number of threads used for T1 compression. Default is total number of logical\n");
   fprintf(stdout, "cores.\n");
   fprintf(stdout, "\n");
+  fprintf(stdout, " `-B, --tiles-in-flight [number of tiles]`\n");
+  fprintf(stdout, "\n");
+  fprintf(stdout, "Maximum number of tiles compressed concurrently. Tiles are written in\n");
+  fprintf(stdout, "order as soon as they are complete, so peak memory scales with this number.\n");
+  fprintf(stdout, "Default is number of worker threads.\n");
+  fprintf(stdout, "\n");
   fprintf(stdout, " `-J, --duration [duration]`\n");
   fprintf(stdout, "\n");
   fprintf(stdout, "Duration in seconds for a batch compress job. `grk_compress` will exit when\n");
@@ -1056,7 +1062,7 @@ GrkRC GrkCompress::parseCommandLine(int argc, char* argv[], CompressInitParams*
   int32_t deviceId;
   uint8_t resolutions;
   uint32_t rateControlAlgorithm, repetitions, numThreads, kernelBuildOptions, duration, mode,
-      guardBits, mct;
+      guardBits, mct, tilesInFlight;
   std::string tileParts;
   uint16_t rsiz;
 
@@ -1066,6 +1072,9 @@ GrkRC GrkCompress::parseCommandLine(int argc, char* argv[], CompressInitParams*
   auto rateControlAlgorithmOpt =
       app.add_option("-A,--rate-control-algorithm", rateControlAlgorithm, "Rate control algorithm")
           ->default_val(0);
+  auto tilesInFlightOpt = app.add_option("-B,--tiles-in-flight", tilesInFlight,
+                                         "Maximum number of tiles compressed concurrently")
+                              ->default_val(0);
   auto codeBlockDimsOpt =
       app.add_option("-b,--code-block-dims", codeBlockDims, "Code block dimensions");
   auto precinctDimsOpt = app.add_option("-c,--precinct-dims", precinctDims, "Precinct dimensions");
@@ -1173,6 +1182,8 @@ GrkRC GrkCompress::parseCommandLine(int argc, char* argv[], CompressInitParams*
   }
   if(numThreadsOpt->count() > 0)
     parameters->num_threads = numThreads;
+  if(tilesInFlightOpt->count() > 0)
+    parameters->max_tiles_in_flight = tilesInFlight;
   if(deviceIdOpt->count() > 0)
     parameters->device_id = deviceId;
   if(durationOpt->count() > 0)
@@ -58,8 +58,13 @@ typedef struct _img_folder
   bool set_out_format;
 
   uint32_t flag;
+  /** Build sidecar code stream index instead of dumping*/
+  bool build_index;
 } inputFolder;
 
+// file name suffix of sidecar code stream index
+static const char* indexSuffix = ".gidx";
+
 static int loadImages(dircnt* dirptr, char* imgdirpath);
 static char nextFile(size_t imageno, dircnt* dirptr, inputFolder* inputFolder,
                      grk_decompress_parameters* parameters);
@@ -92,6 +97,13 @@ static void decompress_help_display(void)
   fprintf(stdout, "    OPTIONAL\n");
   fprintf(stdout, "    Enable informative messages\n");
   fprintf(stdout, "    By default verbose mode is off.\n");
+  fprintf(stdout, "  -x ");
+  fprintf(stdout, "    OPTIONAL\n");
+  fprintf(stdout, "    Instead of dumping, decompress each image and write a sidecar code\n");
+  fprintf(stdout, "    stream index <compressed file>%s next to it. The index lets\n",
+          indexSuffix);
+  fprintf(stdout, "    region decompression skip straight to the tile parts and packets\n");
+  fprintf(stdout, "    it needs, when passed as the index_file decompress parameter.\n");
   fprintf(stdout, "\n");
 }
 
@@ -162,6 +174,7 @@ static int parseCommandLine(int argc, char** argv, grk_decompress_parameters* pa
                                           cmd);
 
     TCLAP::SwitchArg verboseArg("v", "verbose", "verbose", cmd);
+    TCLAP::SwitchArg indexArg("x", "index", "build code stream index", cmd);
     TCLAP::ValueArg<uint32_t> flagArg("f", "flag", "flag", false, 0, "unsigned integer", cmd);
 
     cmd.parse(argc, argv);
@@ -198,6 +211,7 @@ static int parseCommandLine(int argc, char** argv, grk_decompress_parameters* pa
     }
     if(flagArg.isSet())
       inputFolder->flag = flagArg.getValue();
+    inputFolder->build_index = indexArg.isSet();
   }
   catch(const TCLAP::ArgException& e) // catch any exceptions
   {
@@ -213,7 +227,7 @@ static int parseCommandLine(int argc, char** argv, grk_decompress_parameters* pa
       spdlog::error("options --batch-src and -i cannot be used together.");
       return 1;
     }
-    if(!inputFolder->set_out_format)
+    if(!inputFolder->set_out_format && !inputFolder->build_index)
     {
       spdlog::error("When --batch-src is used, --out-fmt <FORMAT> must be used.");
       spdlog::error("Only one format allowed.\n"
@@ -337,6 +351,16 @@ int GrkDump::main(int argc, char* argv[])
     }
     grk_stream_params stream_params = {};
     stream_params.file = parameters.infile;
+    std::string indexFile = std::string(parameters.infile) + indexSuffix;
+    if(inputFolder.build_index)
+    {
+      // remove stale index, so that it is rebuilt rather than used
+      std::error_code ec;
+      std::filesystem::remove(indexFile, ec);
+      parameters.core.index_file = indexFile.c_str();
+      parameters.core.skip_allocate_composite = true;
+      parameters.core.tile_cache_strategy = GRK_TILE_CACHE_NONE;
+    }
     codec = grk_decompress_init(&stream_params, &parameters);
     if(!codec)
     {
@@ -353,7 +377,22 @@ int GrkDump::main(int argc, char* argv[])
       goto cleanup;
     }
 
-    grk_dump_codec(codec, inputFolder.flag, fout);
+    if(inputFolder.build_index)
+    {
+      // the index is written once the whole code stream has been decompressed
+      std::error_code ec;
+      if(!grk_decompress(codec, nullptr) || !std::filesystem::exists(indexFile, ec))
+      {
+        spdlog::error("grk_dump: failed to build code stream index for {}", parameters.infile);
+        rc = EXIT_FAILURE;
+        goto cleanup;
+      }
+      spdlog::info("Wrote code stream index {}", indexFile);
+    }
+    else
+    {
+      grk_dump_codec(codec, inputFolder.flag, fout);
+    }
     /* free remaining structures */
     if(codec)
     {
@@ -0,0 +1,204 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace grk
+{
+
+/**
+ * @class Arena
+ * @brief Bump allocator for short-lived codec structures.
+ *
+ * Memory is carved out of a list of aligned chunks and is never returned individually:
+ * reset() rewinds the arena in one shot while keeping its chunks, so that the next user
+ * with a similar allocation pattern does not touch the system allocator at all.
+ * Objects placed in the arena must have their destructors run explicitly (see arenaDelete).
+ *
+ * Allocation is thread safe, since packet headers of different precincts are parsed
+ * concurrently.
+ */
+class Arena
+{
+public:
+  Arena(void) : currChunk_(0), offset_(0) {}
+  ~Arena(void)
+  {
+    for(auto& c : chunks_)
+      grk_aligned_free(c.data);
+  }
+  /**
+   * @brief Allocates uninitialized memory
+   * @param size bytes to allocate
+   * @param align alignment, which must be a power of two no larger than 64
+   * @return pointer to memory, which lives until the arena is reset or destroyed
+   * @throws std::bad_alloc if system memory is exhausted
+   */
+  void* alloc(size_t size, size_t align = alignof(std::max_align_t))
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(currChunk_ < chunks_.size())
+    {
+      size_t offset = (offset_ + align - 1) & ~(align - 1);
+      auto chunk = chunks_.data() + currChunk_;
+      if(offset + size <= chunk->len)
+      {
+        offset_ = offset + size;
+        return chunk->data + offset;
+      }
+      currChunk_++;
+    }
+    // chunk data is 64 byte aligned, so a fresh chunk satisfies any supported alignment
+    while(currChunk_ < chunks_.size() && chunks_[currChunk_].len < size)
+      currChunk_++;
+    if(currChunk_ == chunks_.size())
+    {
+      size_t len = chunks_.empty() ? minChunkLen : std::min(chunks_.back().len * 2, maxChunkLen);
+      len = std::max(len, size);
+      auto data = (uint8_t*)grk_aligned_malloc(len);
+      if(!data)
+        throw std::bad_alloc();
+      chunks_.push_back({data, len});
+    }
+    offset_ = size;
+
+    return chunks_[currChunk_].data;
+  }
+  /**
+   * @brief Constructs an object in the arena
+   */
+  template<typename T, typename... Args>
+  T* create(Args&&... args)
+  {
+    return new(alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+  /**
+   * @brief Allocates a value-initialized array of trivial type in the arena
+   */
+  template<typename T>
+  T* createArray(size_t count)
+  {
+    static_assert(std::is_trivially_destructible_v<T>);
+    return new(alloc(count * sizeof(T), alignof(T))) T[count]();
+  }
+  /**
+   * @brief Gets total bytes of all chunks held by the arena
+   */
+  size_t capacity(void)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t rc = 0;
+    for(auto& c : chunks_)
+      rc += c.len;
+
+    return rc;
+  }
+  /**
+   * @brief Rewinds the arena, keeping all chunks for re-use
+   *
+   * All objects allocated from the arena must already be destroyed.
+   */
+  void reset(void)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    currChunk_ = 0;
+    offset_ = 0;
+  }
+
+private:
+  struct ArenaChunk
+  {
+    uint8_t* data;
+    size_t len;
+  };
+  static constexpr size_t minChunkLen = 64 * 1024;
+  static constexpr size_t maxChunkLen = 16 * 1024 * 1024;
+  std::mutex mutex_;
+  std::vector<ArenaChunk> chunks_;
+  size_t currChunk_;
+  size_t offset_;
+};
+
+/**
+ * @brief Constructs an object in an arena, or on the heap if there is no arena
+ */
+template<typename T, typename... Args>
+T* arenaNew(Arena* arena, Args&&... args)
+{
+  return arena ? arena->create<T>(std::forward<Args>(args)...)
+               : new T(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Destroys an object created by arenaNew with the same arena
+ */
+template<typename T>
+void arenaDelete(Arena* arena, T* obj)
+{
+  if(!obj)
+    return;
+  if(arena)
+    obj->~T();
+  else
+    delete obj;
+}
+
+/**
+ * @class ArenaPool
+ * @brief Pool of arenas shared by the tile processors of a code stream
+ *
+ * A tile processor acquires an arena before building its tile, and returns it when the
+ * tile is released: later tiles, which usually share geometry, then re-use its chunks.
+ */
+class ArenaPool
+{
+public:
+  ArenaPool(void) = default;
+  ~ArenaPool(void)
+  {
+    for(auto a : arenas_)
+      delete a;
+  }
+  Arena* acquire(void)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(arenas_.empty())
+      return new Arena();
+    auto arena = arenas_.back();
+    arenas_.pop_back();
+
+    return arena;
+  }
+  void release(Arena* arena)
+  {
+    if(!arena)
+      return;
+    arena->reset();
+    std::lock_guard<std::mutex> lock(mutex_);
+    arenas_.push_back(arena);
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<Arena*> arenas_;
+};
+
+} // namespace grk
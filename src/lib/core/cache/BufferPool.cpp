@@ -0,0 +1,92 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bit>
+#include <grk_includes.h>
+
+namespace grk
+{
+BufferPool::BufferPool(void) : pooledBytes_(0) {}
+BufferPool::~BufferPool(void)
+{
+  clear();
+}
+BufferPool& BufferPool::get(void)
+{
+  static BufferPool pool;
+
+  return pool;
+}
+size_t BufferPool::classSize(size_t size)
+{
+  if(size <= minPooledSize)
+    return size;
+  // round up to next multiple of a quarter of the largest power of two <= size
+  size_t step = (size_t)1 << (std::bit_width(size) - 3);
+
+  return ((size + step - 1) / step) * step;
+}
+void* BufferPool::acquire(size_t size)
+{
+  if(size == 0)
+    return nullptr;
+  auto cls = classSize(size);
+  if(cls > minPooledSize)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = bins_.find(cls);
+    if(it != bins_.end() && !it->second.empty())
+    {
+      auto buf = it->second.back();
+      it->second.pop_back();
+      pooledBytes_ -= cls;
+
+      return buf;
+    }
+  }
+
+  return grk_aligned_malloc(cls);
+}
+void BufferPool::release(void* buf, size_t size)
+{
+  if(!buf)
+    return;
+  auto cls = classSize(size);
+  if(cls > minPooledSize)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(pooledBytes_ + cls <= maxPooledBytes)
+    {
+      bins_[cls].push_back(buf);
+      pooledBytes_ += cls;
+      return;
+    }
+  }
+  grk_aligned_free(buf);
+}
+void BufferPool::clear(void)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for(auto& bin : bins_)
+  {
+    for(auto buf : bin.second)
+      grk_aligned_free(buf);
+  }
+  bins_.clear();
+  pooledBytes_ = 0;
+}
+
+} // namespace grk
@@ -0,0 +1,74 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace grk
+{
+
+/**
+ * @class BufferPool
+ * @brief Process wide pool of aligned buffers, binned by size class
+ *
+ * Tiles of a multi-tile image usually share geometry, so their window buffers
+ * and sparse canvas blocks have the same handful of sizes. Released buffers are kept
+ * in the bin of their size class, and handed out again to the next tile,
+ * from any code stream. Size classes are spaced at a quarter of a power of two,
+ * so a buffer wastes at most 25% of its size.
+ *
+ * Buffers are uninitialized : callers zero them only where the algorithm needs it.
+ */
+class BufferPool
+{
+public:
+  /**
+   * @brief Gets the process wide pool
+   */
+  static BufferPool& get(void);
+  /**
+   * @brief Acquires a buffer
+   * @param size bytes needed
+   * @return buffer of at least size bytes, or nullptr if system memory is exhausted
+   */
+  void* acquire(size_t size);
+  /**
+   * @brief Returns a buffer acquired from this pool
+   * @param buf buffer
+   * @param size size that buffer was acquired with
+   */
+  void release(void* buf, size_t size);
+  /**
+   * @brief Frees all pooled buffers
+   */
+  void clear(void);
+
+private:
+  BufferPool(void);
+  ~BufferPool(void);
+  static size_t classSize(size_t size);
+  std::mutex mutex_;
+  std::unordered_map<size_t, std::vector<void*>> bins_;
+  size_t pooledBytes_;
+  // pooled buffers beyond this limit are freed, to bound memory held between decompressions
+  static constexpr size_t maxPooledBytes = (size_t)512 * 1024 * 1024;
+  // smaller buffers are cheap to allocate, and are not worth the lock
+  static constexpr size_t minPooledSize = 4096;
+};
+
+} // namespace grk
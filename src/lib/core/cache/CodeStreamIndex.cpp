@@ -0,0 +1,329 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "grk_includes.h"
+#include <list>
+
+namespace grk
+{
+// sidecar file : magic, version, source identity, number of tiles, main header,
+// tile parts, then comma coded packet lengths per tile. All values are big endian
+const uint32_t indexMagic = 0x47524B49; // GRKI
+const uint32_t indexVersion = 2;
+
+// packet lengths are installed as PLT markers of at most this many bytes
+const size_t indexPLTChunkLen = 65000;
+
+// process-wide index cache : most recently used index first
+static std::mutex indexCacheMutex;
+static std::list<std::shared_ptr<CodeStreamIndex>> indexCache;
+static uint64_t indexCacheBytes = 0;
+const uint64_t indexCacheMaxBytes = 256 * 1024 * 1024;
+
+// reads big endian values from a sidecar file buffer, with bounds checking
+class IndexReader
+{
+public:
+  IndexReader(const uint8_t* data, size_t len) : data_(data), len_(len), offset_(0) {}
+  template<typename T>
+  bool read(T* value)
+  {
+    if(len_ - offset_ < sizeof(T))
+      return false;
+    grk_read(data_ + offset_, value);
+    offset_ += sizeof(T);
+    return true;
+  }
+  bool read(std::vector<uint8_t>& bytes, size_t numBytes)
+  {
+    if(len_ - offset_ < numBytes)
+      return false;
+    bytes.assign(data_ + offset_, data_ + offset_ + numBytes);
+    offset_ += numBytes;
+    return true;
+  }
+  bool atEnd(void)
+  {
+    return offset_ == len_;
+  }
+
+private:
+  const uint8_t* data_;
+  size_t len_;
+  size_t offset_;
+};
+
+template<typename T>
+static void indexWrite(std::vector<uint8_t>& buf, T value)
+{
+  size_t offset = buf.size();
+  buf.resize(offset + sizeof(T));
+  grk_write(buf.data() + offset, value);
+}
+
+IndexedTilePart::IndexedTilePart(uint16_t tileIndex, uint64_t position, uint64_t length)
+    : tileIndex_(tileIndex), position_(position), length_(length)
+{}
+IndexedTilePart::IndexedTilePart(void) : IndexedTilePart(0, 0, 0) {}
+
+CodeStreamIndex::CodeStreamIndex(const std::string& source, std::vector<uint8_t>&& mainHeader,
+                                 uint16_t numTiles)
+    : source_(source), mainHeader_(std::move(mainHeader)), numTiles_(numTiles)
+{}
+std::shared_ptr<CodeStreamIndex> CodeStreamIndex::load(const char* path)
+{
+  auto fp = fopen(path, "rb");
+  if(!fp)
+    return nullptr;
+  std::vector<uint8_t> data;
+  uint8_t chunk[65536];
+  size_t bytesRead;
+  while((bytesRead = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+    data.insert(data.end(), chunk, chunk + bytesRead);
+  fclose(fp);
+
+  IndexReader reader(data.data(), data.size());
+  uint32_t magic, version, sourceLength, mainHeaderLength, numTileParts, numPacketLengthTiles;
+  uint16_t numTiles;
+  std::vector<uint8_t> source, mainHeader;
+  if(!reader.read(&magic) || magic != indexMagic || !reader.read(&version) ||
+     version != indexVersion)
+  {
+    grklog.warn("%s is not a code stream index", path);
+    return nullptr;
+  }
+  if(!reader.read(&sourceLength) || !reader.read(source, sourceLength) ||
+     !reader.read(&numTiles) || !reader.read(&mainHeaderLength) ||
+     !reader.read(mainHeader, mainHeaderLength))
+  {
+    grklog.warn("Code stream index %s is truncated", path);
+    return nullptr;
+  }
+  auto index = std::make_shared<CodeStreamIndex>(std::string(source.begin(), source.end()),
+                                                 std::move(mainHeader), numTiles);
+  bool valid = reader.read(&numTileParts);
+  for(uint32_t i = 0; valid && i < numTileParts; ++i)
+  {
+    IndexedTilePart tilePart;
+    valid = reader.read(&tilePart.tileIndex_) && reader.read(&tilePart.position_) &&
+            reader.read(&tilePart.length_) && tilePart.tileIndex_ < numTiles &&
+            (index->tileParts_.empty() || tilePart.position_ > index->tileParts_.back().position_);
+    if(valid)
+      index->tileParts_.push_back(tilePart);
+  }
+  valid = valid && reader.read(&numPacketLengthTiles);
+  for(uint32_t i = 0; valid && i < numPacketLengthTiles; ++i)
+  {
+    uint16_t tileIndex;
+    uint32_t numBytes;
+    std::vector<uint8_t> packetLengths;
+    valid = reader.read(&tileIndex) && reader.read(&numBytes) &&
+            reader.read(packetLengths, numBytes) && tileIndex < numTiles &&
+            (packetLengths.empty() || !(packetLengths.back() & 0x80));
+    if(valid)
+      index->packetLengths_[tileIndex] = std::move(packetLengths);
+  }
+  if(!valid || !reader.atEnd() || !index->isComplete())
+  {
+    grklog.warn("Code stream index %s is corrupt", path);
+    return nullptr;
+  }
+
+  return index;
+}
+bool CodeStreamIndex::save(const char* path)
+{
+  std::vector<uint8_t> buf;
+  indexWrite(buf, indexMagic);
+  indexWrite(buf, indexVersion);
+  indexWrite(buf, (uint32_t)source_.size());
+  buf.insert(buf.end(), source_.begin(), source_.end());
+  indexWrite(buf, numTiles_);
+  indexWrite(buf, (uint32_t)mainHeader_.size());
+  buf.insert(buf.end(), mainHeader_.begin(), mainHeader_.end());
+  indexWrite(buf, (uint32_t)tileParts_.size());
+  for(const auto& tilePart : tileParts_)
+  {
+    indexWrite(buf, tilePart.tileIndex_);
+    indexWrite(buf, tilePart.position_);
+    indexWrite(buf, tilePart.length_);
+  }
+  {
+    std::lock_guard<std::mutex> lock(packetLengthsMutex_);
+    indexWrite(buf, (uint32_t)packetLengths_.size());
+    for(const auto& [tileIndex, packetLengths] : packetLengths_)
+    {
+      indexWrite(buf, tileIndex);
+      indexWrite(buf, (uint32_t)packetLengths.size());
+      buf.insert(buf.end(), packetLengths.begin(), packetLengths.end());
+    }
+  }
+  auto fp = fopen(path, "wb");
+  if(!fp)
+  {
+    grklog.error("Unable to open code stream index %s for writing", path);
+    return false;
+  }
+  bool rc = fwrite(buf.data(), 1, buf.size(), fp) == buf.size();
+  rc = (fclose(fp) == 0) && rc;
+  if(!rc)
+    grklog.error("Unable to write code stream index %s", path);
+
+  return rc;
+}
+std::shared_ptr<CodeStreamIndex> CodeStreamIndex::findCached(const std::string& source,
+                                                             const std::vector<uint8_t>& mainHeader)
+{
+  std::lock_guard<std::mutex> lock(indexCacheMutex);
+  for(auto it = indexCache.begin(); it != indexCache.end(); ++it)
+  {
+    if((*it)->matches(source, mainHeader))
+    {
+      indexCache.splice(indexCache.begin(), indexCache, it);
+      return indexCache.front();
+    }
+  }
+
+  return nullptr;
+}
+void CodeStreamIndex::cache(std::shared_ptr<CodeStreamIndex> index)
+{
+  std::lock_guard<std::mutex> lock(indexCacheMutex);
+  for(const auto& cached : indexCache)
+  {
+    if(cached->matches(index->source_, index->mainHeader_))
+      return;
+  }
+  indexCache.push_front(index);
+  indexCacheBytes += index->getMemoryFootprint();
+  while(indexCacheBytes > indexCacheMaxBytes && indexCache.size() > 1)
+  {
+    indexCacheBytes -= indexCache.back()->getMemoryFootprint();
+    indexCache.pop_back();
+  }
+}
+bool CodeStreamIndex::matches(const std::string& source,
+                              const std::vector<uint8_t>& mainHeader) const
+{
+  return source_ == source && mainHeader_ == mainHeader;
+}
+void CodeStreamIndex::pushTilePart(uint16_t tileIndex, uint64_t position, uint64_t length)
+{
+  if(!tileParts_.empty() && position <= tileParts_.back().position_)
+    return;
+  tileParts_.emplace_back(tileIndex, position, length);
+}
+void CodeStreamIndex::setPacketLengths(uint16_t tileIndex, std::vector<uint8_t>&& packetLengths)
+{
+  std::lock_guard<std::mutex> lock(packetLengthsMutex_);
+  packetLengths_[tileIndex] = std::move(packetLengths);
+}
+bool CodeStreamIndex::isComplete(void) const
+{
+  std::vector<bool> indexed(numTiles_);
+  uint16_t numIndexed = 0;
+  for(const auto& tilePart : tileParts_)
+  {
+    if(!indexed[tilePart.tileIndex_])
+    {
+      indexed[tilePart.tileIndex_] = true;
+      numIndexed++;
+    }
+  }
+
+  return numIndexed == numTiles_;
+}
+const IndexedTilePart* CodeStreamIndex::nextTilePart(uint64_t position, TileSet* tiles) const
+{
+  auto it = std::lower_bound(tileParts_.begin(), tileParts_.end(), position,
+                             [](const IndexedTilePart& tilePart, uint64_t pos) {
+                               return tilePart.position_ < pos;
+                             });
+  for(; it != tileParts_.end(); ++it)
+  {
+    if(tiles->isScheduled(it->tileIndex_) && !tiles->isComplete(it->tileIndex_))
+      return &*it;
+  }
+
+  return nullptr;
+}
+const IndexedTilePart* CodeStreamIndex::firstTilePart(uint16_t tileIndex) const
+{
+  for(const auto& tilePart : tileParts_)
+  {
+    if(tilePart.tileIndex_ == tileIndex)
+      return &tilePart;
+  }
+
+  return nullptr;
+}
+bool CodeStreamIndex::hasTilePart(uint16_t tileIndex, uint64_t position) const
+{
+  auto it = std::lower_bound(tileParts_.begin(), tileParts_.end(), position,
+                             [](const IndexedTilePart& tilePart, uint64_t pos) {
+                               return tilePart.position_ < pos;
+                             });
+
+  return it != tileParts_.end() && it->position_ == position && it->tileIndex_ == tileIndex;
+}
+bool CodeStreamIndex::installPacketLengths(uint16_t tileIndex, PLCache* cache) const
+{
+  auto it = packetLengths_.find(tileIndex);
+  if(it == packetLengths_.end() || it->second.empty())
+    return true;
+  auto markers = cache->createMarkers(nullptr);
+  const auto& packetLengths = it->second;
+  std::vector<uint8_t> marker;
+  uint8_t Zplt = 0;
+  size_t begin = 0;
+  while(begin < packetLengths.size())
+  {
+    // split at the end of a packet length
+    size_t end = std::min(begin + indexPLTChunkLen, packetLengths.size());
+    while(packetLengths[end - 1] & 0x80)
+      end--;
+    marker.assign(1, Zplt++);
+    marker.insert(marker.end(), packetLengths.begin() + (ptrdiff_t)begin,
+                  packetLengths.begin() + (ptrdiff_t)end);
+    if(!markers->readPLT(marker.data(), (uint16_t)marker.size()))
+    {
+      cache->deleteMarkers();
+      return false;
+    }
+    begin = end;
+  }
+
+  return true;
+}
+void CodeStreamIndex::pushPacketLength(std::vector<uint8_t>& packetLengths, uint32_t len)
+{
+  assert(len);
+  uint32_t numBytes = (floorlog2(len) + 7U) / 7U;
+  for(uint32_t i = numBytes; i > 1; --i)
+    packetLengths.push_back((uint8_t)(((len >> (7 * (i - 1))) & 0x7F) | 0x80));
+  packetLengths.push_back((uint8_t)(len & 0x7F));
+}
+uint64_t CodeStreamIndex::getMemoryFootprint(void) const
+{
+  uint64_t bytes = sizeof(CodeStreamIndex) + source_.size() + mainHeader_.size() +
+                   tileParts_.size() * sizeof(IndexedTilePart);
+  for(const auto& packetLengths : packetLengths_)
+    bytes += packetLengths.second.size();
+
+  return bytes;
+}
+
+} // namespace grk
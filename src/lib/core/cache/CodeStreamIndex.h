@@ -0,0 +1,154 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#include <vector>
+#include <map>
+#include <string>
+#include <memory>
+#include <mutex>
+
+namespace grk
+{
+/**
+ * Location of a tile part in the code stream
+ */
+struct IndexedTilePart
+{
+  IndexedTilePart(uint16_t tileIndex, uint64_t position, uint64_t length);
+  IndexedTilePart(void);
+  uint16_t tileIndex_;
+  /** position of SOT marker */
+  uint64_t position_;
+  /** length of tile part, SOT marker segment included */
+  uint64_t length_;
+};
+
+/**
+ * Code stream index
+ *
+ * Holds the main header bytes, the location of every tile part, and the lengths
+ * of the packets of tiles that do not signal them in PLT markers. The index is built
+ * while a code stream is parsed from beginning to end, and may be saved to a sidecar file.
+ * When the code stream is reopened, the index lets the decompressor seek straight to the
+ * tile parts it needs, and skip packets outside the decompress window without
+ * parsing their headers.
+ *
+ * An index matches a code stream if the identity of the stream source (for a file,
+ * its path, length and modification time) and the main header bytes are identical.
+ * Indices can also be kept in a process-wide cache keyed by the same identity, so that
+ * a code stream reopened in the same process is not scanned again. Since an identity
+ * can still collide, for example when a file is rewritten within the resolution of its
+ * modification time, the decompressor verifies each indexed tile part that it seeks to.
+ */
+class CodeStreamIndex
+{
+public:
+  CodeStreamIndex(const std::string& source, std::vector<uint8_t>&& mainHeader,
+                  uint16_t numTiles);
+  /**
+   * Loads index from sidecar file
+   *
+   * @param path sidecar file path
+   * @return index, or nullptr if the file is missing or corrupt
+   */
+  static std::shared_ptr<CodeStreamIndex> load(const char* path);
+  /**
+   * Saves index to sidecar file
+   *
+   * @param path sidecar file path
+   * @return true if successful
+   */
+  bool save(const char* path);
+  /**
+   * Finds index in process-wide cache
+   *
+   * @param source identity of stream source
+   * @param mainHeader main header bytes
+   * @return index, or nullptr if there is no matching index in the cache
+   */
+  static std::shared_ptr<CodeStreamIndex> findCached(const std::string& source,
+                                                     const std::vector<uint8_t>& mainHeader);
+  /**
+   * Adds index to process-wide cache, evicting least recently used indices
+   * if the cache is full
+   *
+   * @param index complete index
+   */
+  static void cache(std::shared_ptr<CodeStreamIndex> index);
+  bool matches(const std::string& source, const std::vector<uint8_t>& mainHeader) const;
+  /**
+   * Adds tile part. Tile parts must be added in code stream order : tile parts
+   * that have already been indexed are ignored
+   */
+  void pushTilePart(uint16_t tileIndex, uint64_t position, uint64_t length);
+  /**
+   * Sets comma coded packet lengths for tile. May be called concurrently
+   */
+  void setPacketLengths(uint16_t tileIndex, std::vector<uint8_t>&& packetLengths);
+  /**
+   * Checks if every tile has at least one indexed tile part
+   */
+  bool isComplete(void) const;
+  /**
+   * Gets first tile part at or after position that belongs to a tile
+   * that is scheduled for decompression, and has not yet been completely parsed
+   *
+   * @param position stream position
+   * @param tiles tiles to decompress
+   * @return tile part, or nullptr if there is none
+   */
+  const IndexedTilePart* nextTilePart(uint64_t position, TileSet* tiles) const;
+  /**
+   * Gets first tile part of tile
+   *
+   * @param tileIndex tile index
+   * @return tile part, or nullptr if tile is not indexed
+   */
+  const IndexedTilePart* firstTilePart(uint16_t tileIndex) const;
+  /**
+   * Checks if there is an indexed tile part of tile at position
+   *
+   * @param tileIndex tile index
+   * @param position stream position of SOT marker
+   * @return true if tile part is indexed
+   */
+  bool hasTilePart(uint16_t tileIndex, uint64_t position) const;
+  /**
+   * Installs indexed packet lengths of tile as PLT markers
+   *
+   * @param tileIndex tile index
+   * @param cache tile packet length cache
+   * @return true if successful, or if there are no indexed lengths for this tile
+   */
+  bool installPacketLengths(uint16_t tileIndex, PLCache* cache) const;
+  /**
+   * Appends comma coded packet length
+   */
+  static void pushPacketLength(std::vector<uint8_t>& packetLengths, uint32_t len);
+
+private:
+  uint64_t getMemoryFootprint(void) const;
+  std::string source_;
+  std::vector<uint8_t> mainHeader_;
+  uint16_t numTiles_;
+  // tile parts in code stream order
+  std::vector<IndexedTilePart> tileParts_;
+  std::map<uint16_t, std::vector<uint8_t>> packetLengths_;
+  std::mutex packetLengthsMutex_;
+};
+
+} // namespace grk
@@ -25,6 +25,14 @@
 #include <malloc.h>
 #endif
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#define GRK_HUGE_PAGES
+#endif
+
 #ifndef SIZE_MAX
 #define SIZE_MAX ((size_t)-1)
 #endif
@@ -73,12 +81,109 @@ void* grk_calloc(size_t num, size_t size)
 
   return calloc(num, size);
 }
+#ifdef GRK_HUGE_PAGES
+const size_t grk_huge_page_size = 2 * 1024 * 1024;
+static std::atomic<bool> hugePagesEnabled(false);
+// huge page blocks are mapped directly, so they must be tracked to be unmapped on free.
+// They are aligned to huge page boundaries, so other blocks can be told apart without
+// taking the lock, unless they happen to share that alignment
+static std::mutex hugeMutex;
+static std::unordered_map<void*, size_t> hugeBlocks;
+static std::atomic<size_t> numHugeBlocks(0);
+
+/**
+ * Map block aligned to huge page boundary, and advise kernel to back it with
+ * transparent huge pages. Pages are not touched here, so on NUMA hosts
+ * they are placed on the node of the worker that first writes to them.
+ * Mapped memory is zero initialized.
+ */
+static void* grk_huge_alloc(size_t size)
+{
+  size = ((size + grk_huge_page_size - 1) / grk_huge_page_size) * grk_huge_page_size;
+  size_t mapLen = size + grk_huge_page_size;
+  auto map = (uint8_t*)mmap(nullptr, mapLen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                            -1, 0);
+  if(map == MAP_FAILED)
+    return nullptr;
+  auto aligned = (uint8_t*)(((uintptr_t)map + grk_huge_page_size - 1) &
+                            ~(uintptr_t)(grk_huge_page_size - 1));
+  size_t head = (size_t)(aligned - map);
+  if(head)
+    munmap(map, head);
+  size_t tail = mapLen - head - size;
+  if(tail)
+    munmap(aligned + size, tail);
+  // advisory only : kernel may be configured to never use huge pages
+  madvise(aligned, size, MADV_HUGEPAGE);
+
+  std::lock_guard<std::mutex> lock(hugeMutex);
+  hugeBlocks[aligned] = size;
+  numHugeBlocks++;
+
+  return aligned;
+}
+static bool grk_huge_free(void* ptr)
+{
+  if(((uintptr_t)ptr & (grk_huge_page_size - 1)) || !numHugeBlocks.load(std::memory_order_relaxed))
+    return false;
+  size_t size;
+  {
+    std::lock_guard<std::mutex> lock(hugeMutex);
+    auto it = hugeBlocks.find(ptr);
+    if(it == hugeBlocks.end())
+      return false;
+    size = it->second;
+    hugeBlocks.erase(it);
+    numHugeBlocks--;
+  }
+  munmap(ptr, size);
+
+  return true;
+}
+#endif
+void grk_set_huge_pages(bool enable)
+{
+#ifdef GRK_HUGE_PAGES
+  hugePagesEnabled = enable;
+#else
+  (void)enable;
+#endif
+}
 void* grk_aligned_malloc(size_t size)
 {
+#ifdef GRK_HUGE_PAGES
+  if(hugePagesEnabled && size >= grk_huge_page_size)
+  {
+    auto ptr = grk_huge_alloc(size);
+    if(ptr)
+      return ptr;
+  }
+#endif
   return grk_aligned_alloc_N(grk_buffer_alignment, size);
 }
+void* grk_aligned_calloc(size_t size)
+{
+#ifdef GRK_HUGE_PAGES
+  // fresh mapping is already zeroed, and is left untouched for first touch placement
+  if(hugePagesEnabled && size >= grk_huge_page_size)
+  {
+    auto ptr = grk_huge_alloc(size);
+    if(ptr)
+      return ptr;
+  }
+#endif
+  auto ptr = grk_aligned_alloc_N(grk_buffer_alignment, size);
+  if(ptr)
+    memset(ptr, 0, size);
+
+  return ptr;
+}
 void grk_aligned_free(void* ptr)
 {
+#ifdef GRK_HUGE_PAGES
+  if(ptr && grk_huge_free(ptr))
+    return;
+#endif
 #ifdef _WIN32
   _aligned_free(ptr);
 #else
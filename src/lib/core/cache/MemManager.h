@@ -46,7 +46,21 @@ void* grk_calloc(size_t numOfElements, size_t sizeOfElements);
  @return a void pointer to the allocated space, or nullptr if there is insufficient memory available
  */
 void* grk_aligned_malloc(size_t size);
+/**
+ Allocate aligned memory initialized to 0
+ @param size Bytes to allocate
+ @return a void pointer to the allocated space, or nullptr if there is insufficient memory available
+ */
+void* grk_aligned_calloc(size_t size);
 void grk_aligned_free(void* ptr);
+/**
+ Enable or disable huge page allocation policy (Linux only).
+ When enabled, aligned allocations of at least 2 MB are aligned to 2 MB and advised
+ to use transparent huge pages. Their pages are left untouched on allocation, so on NUMA hosts
+ they are placed on the node of the thread that first writes to them.
+ @param enable true to enable
+ */
+void grk_set_huge_pages(bool enable);
 /**
  Reallocate memory blocks.
  @param m Pointer to previously allocated memory block
@@ -0,0 +1,190 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <grk_includes.h>
+
+namespace grk
+{
+static const char* memCategoryNames[GRK_MEM_NUM_CATEGORIES] = {
+    "compressed data", "tile windows", "composite image", "T1 scratch", "tile cache"};
+
+MemoryTracker::MemoryTracker(void)
+    : total_(0), totalPeak_(0), budget_(0), tileFootprint_(0), tilesInFlight_(0),
+      admissionWaits_(0), warnedOverBudget_(false)
+{
+  for(uint32_t i = 0; i < GRK_MEM_NUM_CATEGORIES; ++i)
+  {
+    current_[i] = 0;
+    peak_[i] = 0;
+  }
+}
+void MemoryTracker::setBudget(uint64_t budget)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = budget;
+}
+void MemoryTracker::updatePeak(std::atomic<uint64_t>& peak, uint64_t value)
+{
+  auto prev = peak.load(std::memory_order_relaxed);
+  while(prev < value && !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed))
+    ;
+}
+void MemoryTracker::charge(GRK_MEM_CATEGORY category, uint64_t bytes)
+{
+  if(!bytes)
+    return;
+  updatePeak(peak_[category], current_[category] += bytes);
+  updatePeak(totalPeak_, total_ += bytes);
+}
+void MemoryTracker::credit(GRK_MEM_CATEGORY category, uint64_t bytes)
+{
+  if(!bytes)
+    return;
+  assert(current_[category] >= bytes);
+  current_[category] -= bytes;
+  total_ -= bytes;
+}
+void MemoryTracker::set(GRK_MEM_CATEGORY category, uint64_t bytes)
+{
+  auto prev = current_[category].exchange(bytes);
+  if(bytes >= prev)
+  {
+    updatePeak(peak_[category], bytes);
+    updatePeak(totalPeak_, total_ += bytes - prev);
+  }
+  else
+  {
+    total_ -= prev - bytes;
+  }
+}
+bool MemoryTracker::canAdmit(uint32_t maxTilesInFlight)
+{
+  if(tilesInFlight_ == 0)
+    return true;
+  if(tilesInFlight_ >= maxTilesInFlight)
+    return false;
+  if(!budget_)
+    return true;
+  // first tile has not been measured yet
+  if(!tileFootprint_)
+    return false;
+  return heldOutsideTiles() + (uint64_t)(tilesInFlight_ + 1) * tileFootprint_ <= budget_;
+}
+uint64_t MemoryTracker::heldOutsideTiles(void)
+{
+  // tile windows and T1 scratch of tiles in flight are covered by their footprint.
+  // Compressed data is held regardless of admission, so waiting cannot release it
+  return current_[GRK_MEM_COMPOSITE] + current_[GRK_MEM_CACHE];
+}
+bool MemoryTracker::tryAdmitTile(uint32_t maxTilesInFlight)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if(!canAdmit(maxTilesInFlight))
+    return false;
+  tilesInFlight_++;
+
+  return true;
+}
+void MemoryTracker::admitTile(uint32_t maxTilesInFlight)
+{
+  if(tryAdmitTile(maxTilesInFlight))
+    return;
+  auto& executor = ExecSingleton::get();
+  std::unique_lock<std::mutex> lock(mutex_);
+  // only waits caused by the budget are counted
+  if(tilesInFlight_ < maxTilesInFlight)
+    admissionWaits_++;
+  if(executor.this_worker_id() >= 0)
+  {
+    lock.unlock();
+    executor.corun_until([this, maxTilesInFlight] { return tryAdmitTile(maxTilesInFlight); });
+  }
+  else
+  {
+    admitCondition_.wait(lock, [this, maxTilesInFlight] { return canAdmit(maxTilesInFlight); });
+    tilesInFlight_++;
+  }
+}
+bool MemoryTracker::allTilesRetired(void)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tilesInFlight_ == 0;
+}
+void MemoryTracker::waitForTiles(void)
+{
+  auto& executor = ExecSingleton::get();
+  if(executor.this_worker_id() >= 0)
+  {
+    executor.corun_until([this] { return allTilesRetired(); });
+  }
+  else
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    admitCondition_.wait(lock, [this] { return tilesInFlight_ == 0; });
+  }
+}
+void MemoryTracker::retireTile(uint64_t footprint)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  assert(tilesInFlight_);
+  tilesInFlight_--;
+  tileFootprint_ = std::max(tileFootprint_, footprint);
+  if(budget_ && !warnedOverBudget_ && heldOutsideTiles() + footprint > budget_)
+  {
+    grklog.warn("Memory budget of %" PRIu64 " bytes is exceeded by a single tile "
+                "of footprint %" PRIu64 " bytes",
+                budget_, footprint);
+    warnedOverBudget_ = true;
+  }
+  // notify while holding lock, as waiter owns the condition variable
+  admitCondition_.notify_all();
+}
+void MemoryTracker::getStats(grk_memory_stats* stats)
+{
+  for(uint32_t i = 0; i < GRK_MEM_NUM_CATEGORIES; ++i)
+  {
+    stats->current[i] = current_[i];
+    stats->peak[i] = peak_[i];
+  }
+  stats->total_current = total_;
+  stats->total_peak = totalPeak_;
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats->budget = budget_;
+  stats->tile_footprint = tileFootprint_;
+  stats->admission_waits = admissionWaits_;
+}
+void MemoryTracker::dump(FILE* outputFileStream)
+{
+  grk_memory_stats stats;
+  getStats(&stats);
+  fprintf(outputFileStream, "Memory accounting {\n");
+  for(uint32_t i = 0; i < GRK_MEM_NUM_CATEGORIES; ++i)
+  {
+    fprintf(outputFileStream, "\t %s: current=%" PRIu64 ", peak=%" PRIu64 "\n",
+            memCategoryNames[i], stats.current[i], stats.peak[i]);
+  }
+  fprintf(outputFileStream, "\t total: current=%" PRIu64 ", peak=%" PRIu64 "\n",
+          stats.total_current, stats.total_peak);
+  if(stats.budget)
+  {
+    fprintf(outputFileStream, "\t budget=%" PRIu64 ", tile footprint=%" PRIu64
+            ", admission waits=%" PRIu64 "\n",
+            stats.budget, stats.tile_footprint, stats.admission_waits);
+  }
+  fprintf(outputFileStream, "}\n");
+}
+
+} // namespace grk
@@ -0,0 +1,100 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+
+namespace grk
+{
+
+/**
+ * @class MemoryTracker
+ * @brief Per codec accounting of bytes held, by category, with an optional tile admission budget
+ *
+ * Each category tracks current and peak bytes. Tile window and T1 memory is covered by
+ * admission: a tile waits to be admitted until the composite and cache bytes, plus the
+ * footprint of every tile in flight, fits in the budget. Compressed tile data is held for
+ * the life of the code stream whether or not tiles are admitted, so it is reported but not
+ * counted against the budget. The per-tile footprint
+ * is measured as tiles complete, so until the first tile has been measured, tiles are
+ * admitted one at a time.
+ *
+ * Only the thread that schedules tiles waits for admission : tiles themselves never block,
+ * since a worker co-running a tile's flows may pick up another tile's task.
+ */
+class MemoryTracker
+{
+public:
+  MemoryTracker(void);
+  /**
+   * @brief Sets the tile admission budget (0 means no budget)
+   */
+  void setBudget(uint64_t budget);
+  /**
+   * @brief Adds bytes to a category
+   */
+  void charge(GRK_MEM_CATEGORY category, uint64_t bytes);
+  /**
+   * @brief Removes bytes from a category
+   */
+  void credit(GRK_MEM_CATEGORY category, uint64_t bytes);
+  /**
+   * @brief Sets the bytes currently held by a category
+   */
+  void set(GRK_MEM_CATEGORY category, uint64_t bytes);
+  /**
+   * @brief Waits until a tile can be admitted within the budget
+   *
+   * A calling worker co-runs other tasks while it waits, rather than blocking
+   * @param maxTilesInFlight maximum number of tiles in flight, regardless of budget
+   */
+  void admitTile(uint32_t maxTilesInFlight);
+  /**
+   * @brief Retires an admitted tile
+   * @param footprint measured tile window and T1 bytes of the tile, or zero if not measured
+   */
+  void retireTile(uint64_t footprint);
+  /**
+   * @brief Waits until all admitted tiles have retired
+   */
+  void waitForTiles(void);
+  void getStats(grk_memory_stats* stats);
+  void dump(FILE* outputFileStream);
+
+private:
+  void updatePeak(std::atomic<uint64_t>& peak, uint64_t value);
+  bool canAdmit(uint32_t maxTilesInFlight);
+  bool tryAdmitTile(uint32_t maxTilesInFlight);
+  bool allTilesRetired(void);
+  uint64_t heldOutsideTiles(void);
+  std::atomic<uint64_t> current_[GRK_MEM_NUM_CATEGORIES];
+  std::atomic<uint64_t> peak_[GRK_MEM_NUM_CATEGORIES];
+  std::atomic<uint64_t> total_;
+  std::atomic<uint64_t> totalPeak_;
+  // admission state is guarded by mutex_
+  std::mutex mutex_;
+  std::condition_variable admitCondition_;
+  uint64_t budget_;
+  uint64_t tileFootprint_;
+  uint32_t tilesInFlight_;
+  uint64_t admissionWaits_;
+  bool warnedOverBudget_;
+};
+
+} // namespace grk
@@ -102,6 +102,14 @@ bool PLMarkerMgr::pushPL(uint32_t len)
       buf = addNewMarker(nullptr, plWriteBufferLen);
       buf->write(newMarkerId);
     }
+    else
+    {
+      // when simulating, buffer only tracks marker length, so that markers
+      // are split exactly as they will be in the final pass
+      buf = addNewMarker(nullptr, 0);
+      buf->len = plWriteBufferLen;
+      buf->offset = 1;
+    }
     // account for marker header
     totalBytesWritten_ += 2 + 2 + 1;
   }
@@ -127,6 +135,10 @@ bool PLMarkerMgr::pushPL(uint32_t len)
     if(!buf->write(temp, numBytes))
       return false;
   }
+  else
+  {
+    buf->offset += numBytes;
+  }
   totalBytesWritten_ += numBytes;
 
   return true;
@@ -291,11 +303,57 @@ uint32_t PLMarkerMgr::pop(void)
   return rc;
 }
 
+bool PLMarkerMgr::readPLT(uint8_t* headerData, uint16_t headerSize)
+{
+  if(headerSize < 1)
+  {
+    grklog.error("PLT marker segment too short");
+    return false;
+  }
+  uint8_t Zplt = *headerData++;
+  headerSize--;
+  // empty markers carry no packet lengths
+  if(!headerSize)
+    return true;
+  // last byte of a packet length has its most significant bit clear
+  if(headerData[headerSize - 1] & 0x80)
+  {
+    grklog.error("PLT marker segment %u ends with incomplete packet length", Zplt);
+    return false;
+  }
+  if(!findMarker(Zplt, false))
+    return false;
+  addNewMarker(headerData, headerSize);
+
+  return true;
+}
+uint64_t PLMarkerMgr::getNumPacketLengths(void)
+{
+  uint64_t numLengths = 0;
+  for(const auto& marker : *rawMarkers_)
+  {
+    for(auto b : *marker.second)
+    {
+      for(size_t i = 0; i < b->len; ++i)
+        numLengths += (b->buf[i] & 0x80) ? 0 : 1;
+    }
+  }
+
+  return numLengths;
+}
 void PLMarkerMgr::rewind(void)
 {
+  packetLen_ = 0;
+  currMarkerBufIndex_ = 0;
+  currMarkerBuf_ = nullptr;
+  currMarkerIter_ = rawMarkers_->begin();
   if(!rawMarkers_->empty())
   {
-    currMarkerIter_ = rawMarkers_->begin();
+    for(const auto& marker : *rawMarkers_)
+    {
+      for(auto b : *marker.second)
+        b->offset = 0;
+    }
     currMarkerBuf_ = currMarkerIter_->second->front();
   }
 }
@@ -45,6 +45,17 @@ struct PLMarkerMgr
   /////////////////////////////////////////////
   // decompress
   PLMarkerMgr(BufferedStream* strm);
+  /**
+   * @brief Reads a PLT marker segment
+   * @param headerData marker segment data, starting with Zplt
+   * @param headerSize size of marker segment data
+   * @return true if successful
+   */
+  bool readPLT(uint8_t* headerData, uint16_t headerSize);
+  /**
+   * @brief Gets number of complete packet lengths stored in markers
+   */
+  uint64_t getNumPacketLengths(void);
   void rewind(void);
   uint32_t pop(void);
   uint64_t pop(uint64_t numPackets);
@@ -28,13 +28,28 @@ public:
       : chunkSize_(std::min<uint64_t>(maxChunkSize, 1024)), currChunk_(nullptr), currChunkIndex_(0)
   {}
   virtual ~SparseCache(void)
+  {
+    clear();
+  }
+  /**
+   * @brief Destroys all items
+   *
+   * Derived classes that override destroy() must call clear() from their own destructor
+   */
+  void clear(void)
   {
     for(auto& ch : chunks)
     {
       for(size_t i = 0; i < chunkSize_; ++i)
-        delete ch.second[i];
+      {
+        if(ch.second[i])
+          destroy(ch.second[i]);
+      }
       delete[] ch.second;
     }
+    chunks.clear();
+    currChunk_ = nullptr;
+    currChunkIndex_ = 0;
   }
 
   T* tryGet(uint64_t index)
@@ -87,6 +102,10 @@ public:
 
 protected:
   virtual T* create(uint64_t index) = 0;
+  virtual void destroy(T* item)
+  {
+    delete item;
+  }
 
 private:
   std::map<uint64_t, T**> chunks;
@@ -18,17 +18,19 @@
 
 namespace grk
 {
-TileCacheEntry::TileCacheEntry(TileProcessor* p) : processor(p) {}
+TileCacheEntry::TileCacheEntry(TileProcessor* p) : processor(p), bytes(0), admitted(false) {}
 TileCacheEntry::TileCacheEntry() : TileCacheEntry(nullptr) {}
 TileCacheEntry::~TileCacheEntry()
 {
   delete processor;
 }
-TileCache::TileCache(uint32_t strategy) : tileComposite(nullptr), strategy_(strategy)
+TileCache::TileCache(uint32_t strategy, MemoryTracker* memTracker)
+    : tileComposite(nullptr), strategy_(strategy), maxBytes_(0), bytes_(0), hits_(0), misses_(0),
+      evictions_(0), memTracker_(memTracker)
 {
   tileComposite = new GrkImage();
 }
-TileCache::TileCache() : TileCache(GRK_TILE_CACHE_NONE) {}
+TileCache::TileCache(MemoryTracker* memTracker) : TileCache(GRK_TILE_CACHE_NONE, memTracker) {}
 TileCache::~TileCache()
 {
   for(const auto& proc : cache_)
@@ -38,15 +40,33 @@ TileCache::~TileCache()
 }
 bool TileCache::empty()
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   return cache_.empty();
 }
 TileCacheEntry* TileCache::put(uint16_t tile_index, TileProcessor* processor)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   TileCacheEntry* entry = nullptr;
-  if(cache_.find(tile_index) != cache_.end())
+  auto iter = cache_.find(tile_index);
+  if(iter != cache_.end())
   {
-    entry = cache_[tile_index];
-    entry->processor = processor;
+    entry = iter->second;
+    if(entry->processor != processor)
+    {
+      // replaced processor is no longer charged to the cache : new processor
+      // is charged once it is admitted
+      if(entry->admitted)
+      {
+        bytes_ -= entry->bytes;
+        lru_.erase(entry->lruIter);
+        entry->bytes = 0;
+        entry->admitted = false;
+        if(memTracker_)
+          memTracker_->set(GRK_MEM_CACHE, bytes_);
+      }
+      delete entry->processor;
+      entry->processor = processor;
+    }
   }
   else
   {
@@ -58,11 +78,100 @@ TileCacheEntry* TileCache::put(uint16_t tile_index, TileProcessor* processor)
 }
 TileCacheEntry* TileCache::get(uint16_t tile_index)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   if(cache_.find(tile_index) != cache_.end())
     return cache_[tile_index];
 
   return nullptr;
 }
+void TileCache::setMaxBytes(uint64_t maxBytes)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  maxBytes_ = maxBytes;
+}
+uint64_t TileCache::getMaxBytes(void)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return maxBytes_;
+}
+bool TileCache::hit(uint16_t tile_index)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = cache_.find(tile_index);
+  if(iter == cache_.end() || !iter->second->processor || !iter->second->processor->getImage())
+  {
+    misses_++;
+    return false;
+  }
+  hits_++;
+  auto entry = iter->second;
+  if(entry->admitted)
+    lru_.splice(lru_.begin(), lru_, entry->lruIter);
+
+  return true;
+}
+void TileCache::admit(uint16_t tile_index)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = cache_.find(tile_index);
+  if(iter == cache_.end() || !iter->second->processor)
+    return;
+  auto entry = iter->second;
+  // a processor that has not released its tile still holds the tile's arena
+  uint64_t bytes = 0;
+  auto arena = entry->processor->getArena();
+  if(arena)
+    bytes += arena->capacity();
+  auto image = entry->processor->getImage();
+  if(image)
+  {
+    for(uint16_t compno = 0; compno < image->numcomps; ++compno)
+    {
+      auto comp = image->comps + compno;
+      if(comp->data)
+        bytes += (uint64_t)comp->stride * comp->h * sizeof(int32_t);
+    }
+  }
+  if(!bytes)
+    return;
+  if(entry->admitted)
+  {
+    bytes_ -= entry->bytes;
+    lru_.splice(lru_.begin(), lru_, entry->lruIter);
+  }
+  else
+  {
+    lru_.push_front(tile_index);
+    entry->lruIter = lru_.begin();
+    entry->admitted = true;
+  }
+  entry->bytes = bytes;
+  bytes_ += bytes;
+  while(maxBytes_ && bytes_ > maxBytes_ && lru_.size() > 1)
+  {
+    auto victimIter = cache_.find(lru_.back());
+    lru_.pop_back();
+    auto victim = victimIter->second;
+    bytes_ -= victim->bytes;
+    // tile images are only admitted once their processor has finished, so only the
+    // processor's reference to its image, which is the cache's reference, is dropped here.
+    // Images handed out by getImage carry their own reference
+    delete victim;
+    cache_.erase(victimIter);
+    evictions_++;
+  }
+  if(memTracker_)
+    memTracker_->set(GRK_MEM_CACHE, bytes_);
+}
+void TileCache::getStats(grk_tile_cache_stats* stats)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats->hits = hits_;
+  stats->misses = misses_;
+  stats->evictions = evictions_;
+  stats->bytes = bytes_;
+  stats->num_tiles = (uint32_t)lru_.size();
+}
 void TileCache::setStrategy(uint32_t strategy)
 {
   strategy_ = strategy;
@@ -82,9 +191,27 @@ std::vector<GrkImage*> TileCache::getAllImages(void)
 
   return rc;
 }
+GrkImage* TileCache::getImage(uint16_t tile_index)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = cache_.find(tile_index);
+  if(iter == cache_.end() || !iter->second->processor)
+    return nullptr;
+  auto entry = iter->second;
+  if(entry->admitted)
+    lru_.splice(lru_.begin(), lru_, entry->lruIter);
+  // reference is taken while the lock is held, so that the image outlives
+  // an eviction by a concurrent admission
+  auto image = entry->processor->getImage();
+  if(image)
+    grk_object_ref(&image->obj);
+
+  return image;
+}
 std::vector<GrkImage*> TileCache::getTileImages(void)
 {
   std::vector<GrkImage*> rc;
+  std::lock_guard<std::mutex> lock(mutex_);
   for(const auto& entry : cache_)
   {
     auto image = entry.second->processor->getImage();
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <list>
 #include <map>
+#include <mutex>
 
 namespace grk
 {
@@ -30,20 +32,59 @@ struct TileCacheEntry
   ~TileCacheEntry();
 
   TileProcessor* processor;
+  // bytes held by the processor's tile image, once it has been admitted to the LRU list
+  uint64_t bytes;
+  bool admitted;
+  std::list<uint16_t>::iterator lruIter;
 };
 
 class TileCache
 {
 public:
-  TileCache(uint32_t strategy);
-  TileCache(void);
+  TileCache(uint32_t strategy, MemoryTracker* memTracker);
+  explicit TileCache(MemoryTracker* memTracker);
   virtual ~TileCache();
 
   bool empty(void);
   void setStrategy(uint32_t strategy);
   uint32_t getStrategy(void);
+  /**
+   * @brief Puts a tile processor in the cache
+   * @param tile_index tile index
+   * @param processor tile processor, which replaces and deletes any other processor cached
+   * for this tile
+   * @return cache entry
+   */
   TileCacheEntry* put(uint16_t tile_index, TileProcessor* processor);
   TileCacheEntry* get(uint16_t tile_index);
+  /**
+   * @brief Sets the budget for bytes held by cached tile images (0 means unbounded)
+   */
+  void setMaxBytes(uint64_t maxBytes);
+  uint64_t getMaxBytes(void);
+  /**
+   * @brief Checks whether a tile image is cached, updating hit/miss statistics
+   * @param tile_index tile index
+   * @return true if tile image is cached, in which case it becomes most recently used
+   */
+  bool hit(uint16_t tile_index);
+  /**
+   * @brief Gets a cached tile image, which becomes most recently used
+   * @param tile_index tile index
+   * @return new reference to tile image, which the caller releases with grk_object_unref,
+   * or nullptr if tile image is not cached
+   */
+  GrkImage* getImage(uint16_t tile_index);
+  /**
+   * @brief Admits a decompressed tile to the cache
+   *
+   * The tile is charged for its image and for the arena of any tile state it still holds.
+   * Least recently used tiles are evicted, processor and all, while the budget is exceeded.
+   * The tile that was just admitted is never evicted. Eviction only drops the cache's
+   * reference to a tile image.
+   */
+  void admit(uint16_t tile_index);
+  void getStats(grk_tile_cache_stats* stats);
   GrkImage* getComposite(void);
   std::vector<GrkImage*> getAllImages(void);
   std::vector<GrkImage*> getTileImages(void);
@@ -53,6 +94,18 @@ private:
   GrkImage* tileComposite;
   std::map<uint32_t, TileCacheEntry*> cache_;
   uint32_t strategy_;
+  // admitted tiles, most recently used first
+  std::list<uint16_t> lru_;
+  uint64_t maxBytes_;
+  uint64_t bytes_;
+  uint64_t hits_;
+  uint64_t misses_;
+  uint64_t evictions_;
+  // charged for bytes held by admitted tiles
+  MemoryTracker* memTracker_;
+  // guards cache_ : entries may be added by an asynchronous decompression
+  // while the client queries tile images
+  std::mutex mutex_;
 };
 
 } // namespace grk
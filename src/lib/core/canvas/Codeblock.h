@@ -64,8 +64,8 @@ struct Layer
 // note: block lives in canvas coordinates
 struct Codeblock : public grk_buf2d<int32_t, AllocatorAligned>, public ICacheable
 {
-  Codeblock(uint16_t numLayers)
-      : numbps(0), numlenbits(0), numPassesInPacket(nullptr), numlayers_(numLayers)
+  Codeblock(uint16_t numLayers, Arena* arena = nullptr)
+      : numbps(0), numlenbits(0), numPassesInPacket(nullptr), numlayers_(numLayers), arena_(arena)
 #ifdef DEBUG_LOSSLESS_T2
         ,
         included(false)
@@ -74,12 +74,14 @@ struct Codeblock : public grk_buf2d<int32_t, AllocatorAligned>, public ICacheabl
   virtual ~Codeblock()
   {
     compressedStream.dealloc();
-    delete[] numPassesInPacket;
+    if(!arena_)
+      delete[] numPassesInPacket;
   }
   void init(void)
   {
     assert(!numPassesInPacket);
-    numPassesInPacket = new uint8_t[numlayers_];
+    numPassesInPacket =
+        arena_ ? arena_->createArray<uint8_t>(numlayers_) : new uint8_t[numlayers_];
     memset(numPassesInPacket, 0, numlayers_);
   }
   void setRect(grk_rect32 r)
@@ -108,6 +110,8 @@ struct Codeblock : public grk_buf2d<int32_t, AllocatorAligned>, public ICacheabl
 protected:
   uint8_t* numPassesInPacket;
   uint16_t numlayers_;
+  // arena that this block, and its per-layer and per-segment state, are allocated from
+  Arena* arena_;
 #ifdef DEBUG_LOSSLESS_T2
   uint32_t included;
   std::vector<PacketLengthInfo> packet_length_info;
@@ -120,9 +124,9 @@ private:
 
 struct CompressCodeblock : public Codeblock
 {
-  CompressCodeblock(uint16_t numLayers)
-      : Codeblock(numLayers), paddedCompressedStream(nullptr), layers(nullptr), passes(nullptr),
-        numPassesInPreviousPackets(0), numPassesTotal(0)
+  CompressCodeblock(uint16_t numLayers, Arena* arena = nullptr)
+      : Codeblock(numLayers, arena), paddedCompressedStream(nullptr), layers(nullptr),
+        passes(nullptr), numPassesInPreviousPackets(0), numPassesTotal(0)
 #ifdef PLUGIN_DEBUG_ENCODE
         ,
         context_stream(nullptr)
@@ -176,12 +180,12 @@ struct CompressCodeblock : public Codeblock
 
 struct DecompressCodeblock : public Codeblock
 {
-  DecompressCodeblock(uint16_t numLayers)
-      : Codeblock(numLayers), segs(nullptr), numSegments(0),
+  DecompressCodeblock(uint16_t numLayers, Arena* arena = nullptr)
+      : Codeblock(numLayers, arena), segs(nullptr), numSegments(0),
 #ifdef DEBUG_LOSSLESS_T2
         included(0),
 #endif
-        numSegmentsAllocated(0)
+        numSegmentsAllocated(0), segBuffersTail_(0)
   {}
   virtual ~DecompressCodeblock()
   {
@@ -192,16 +196,16 @@ struct DecompressCodeblock : public Codeblock
     if(!segs)
     {
       numSegmentsAllocated = 1;
-      segs = new Segment[numSegmentsAllocated];
+      segs = allocSegments(numSegmentsAllocated);
       numSegmentsAllocated = 1;
     }
     else if(numSegmentsAllocated > 0 && segmentIndex >= numSegmentsAllocated)
     {
-      auto new_segs = new Segment[2 * numSegmentsAllocated];
+      auto new_segs = allocSegments(2 * numSegmentsAllocated);
       for(uint32_t i = 0; i < numSegmentsAllocated; ++i)
         new_segs[i] = segs[i];
       numSegmentsAllocated *= 2;
-      delete[] segs;
+      freeSegments();
       segs = new_segs;
     }
 
@@ -220,12 +224,48 @@ struct DecompressCodeblock : public Codeblock
     numSegments++;
     return getCurrentSegment();
   }
+  /**
+   * Adds segment buffer
+   *
+   * @param buf segment data, owned by the tile part chunk
+   * @param len segment length
+   * @param readableTail number of readable chunk bytes following the segment
+   */
+  void addSegBuffer(uint8_t* buf, size_t len, size_t readableTail)
+  {
+    seg_buffers.push_back(arenaNew<grk_buf8>(arena_, buf, len, false));
+    segBuffersTail_ = readableTail;
+  }
   void cleanUpSegBuffers()
   {
     for(auto& b : seg_buffers)
-      delete b;
+      arenaDelete(arena_, b);
     seg_buffers.clear();
     numSegments = 0;
+    segBuffersTail_ = 0;
+  }
+  /**
+   * Gets segment data as a single span that can be read in place, which is only possible
+   * if all segment buffers are adjacent in their chunk, and at least minTail readable
+   * bytes follow the last buffer
+   *
+   * @param minTail minimum number of readable bytes following the data
+   * @param len total data length
+   * @return pointer to data, or nullptr if data must be copied
+   */
+  uint8_t* getContiguousSegBuffers(size_t minTail, size_t& len)
+  {
+    len = 0;
+    if(seg_buffers.empty() || segBuffersTail_ < minTail)
+      return nullptr;
+    auto start = seg_buffers.front()->buf;
+    for(const auto& b : seg_buffers)
+    {
+      if(b->buf != start + len)
+        return nullptr;
+      len += b->len;
+    }
+    return start;
   }
   size_t getSegBuffersLen()
   {
@@ -250,16 +290,33 @@ struct DecompressCodeblock : public Codeblock
   void release(void)
   {
     cleanUpSegBuffers();
-    delete[] segs;
+    freeSegments();
     segs = nullptr;
     grk_buf2d::dealloc();
   }
   std::vector<grk_buf8*> seg_buffers;
 
 private:
+  Segment* allocSegments(uint32_t numSegments)
+  {
+    if(!arena_)
+      return new Segment[numSegments];
+    auto rc = (Segment*)arena_->alloc(numSegments * sizeof(Segment), alignof(Segment));
+    for(uint32_t i = 0; i < numSegments; ++i)
+      new(rc + i) Segment();
+
+    return rc;
+  }
+  void freeSegments(void)
+  {
+    // arena segments are trivially destructible, and are reclaimed with the arena
+    if(!arena_)
+      delete[] segs;
+  }
   Segment* segs; /* information on segments */
   uint32_t numSegments; /* number of segment in block*/
   uint32_t numSegmentsAllocated; // number of segments allocated for segs array
+  size_t segBuffersTail_; // readable chunk bytes following last segment buffer
 };
 
 } // namespace grk
@@ -18,9 +18,10 @@
 namespace grk
 {
 
-PrecinctImpl::PrecinctImpl(bool isCompressor, grk_rect32* bounds, grk_pt32 cblk_expn)
+PrecinctImpl::PrecinctImpl(bool isCompressor, grk_rect32* bounds, grk_pt32 cblk_expn,
+                           Arena* arena)
     : enc(nullptr), dec(nullptr), bounds_(*bounds), cblk_expn_(cblk_expn),
-      isCompressor_(isCompressor), incltree(nullptr), imsbtree(nullptr)
+      isCompressor_(isCompressor), arena_(arena), incltree(nullptr), imsbtree(nullptr)
 {
   cblk_grid_ =
       grk_rect32(floordivpow2(bounds->x0, cblk_expn.x), floordivpow2(bounds->y0, cblk_expn.y),
@@ -36,7 +37,7 @@ PrecinctImpl::~PrecinctImpl()
 {
   deleteTagTrees();
   delete enc;
-  delete dec;
+  arenaDelete(arena_, dec);
 }
 grk_rect32 PrecinctImpl::getCodeBlockBounds(uint64_t cblkno)
 {
@@ -57,9 +58,10 @@ bool PrecinctImpl::initCodeBlocks(uint16_t numLayers, grk_rect32* bounds)
   if(!num_blocks)
     return true;
   if(isCompressor_)
-    enc = new BlockCache<CompressCodeblock, PrecinctImpl>(numLayers, num_blocks, this);
+    enc = new BlockCache<CompressCodeblock, PrecinctImpl>(numLayers, num_blocks, this, nullptr);
   else
-    dec = new BlockCache<DecompressCodeblock, PrecinctImpl>(numLayers, num_blocks, this);
+    dec = arenaNew<BlockCache<DecompressCodeblock, PrecinctImpl>>(arena_, numLayers, num_blocks,
+                                                                  this, arena_);
 
   return true;
 }
@@ -134,12 +136,18 @@ TagTreeU8* PrecinctImpl::getIMsbTagTree(void)
 Precinct::Precinct(TileProcessor* tileProcessor, const grk_rect32& bounds, grk_pt32 cblk_expn)
     : grk_rect32(bounds), precinctIndex(0),
       numLayers_(tileProcessor->getTileCodingParams()->num_layers_),
-      impl(new PrecinctImpl(tileProcessor->isCompressor(), this, cblk_expn)), cblk_expn_(cblk_expn)
+      arena_(tileProcessor->getArena()),
+      impl(arenaNew<PrecinctImpl>(arena_, tileProcessor->isCompressor(), this, cblk_expn, arena_)),
+      cblk_expn_(cblk_expn)
 
 {}
 Precinct::~Precinct()
 {
-  delete impl;
+  arenaDelete(arena_, impl);
+}
+Arena* Precinct::getArena(void)
+{
+  return arena_;
 }
 void Precinct::deleteTagTrees()
 {
@@ -22,27 +22,36 @@ template<typename T, typename P>
 class BlockCache : public SparseCache<T>
 {
 public:
-  BlockCache(uint16_t numLayers, uint64_t maxChunkSize, P* blockInitializer)
-      : SparseCache<T>(maxChunkSize), blockInitializer_(blockInitializer), numLayers_(numLayers)
+  BlockCache(uint16_t numLayers, uint64_t maxChunkSize, P* blockInitializer, Arena* arena)
+      : SparseCache<T>(maxChunkSize), blockInitializer_(blockInitializer), numLayers_(numLayers),
+        arena_(arena)
   {}
-  virtual ~BlockCache() = default;
+  virtual ~BlockCache()
+  {
+    SparseCache<T>::clear();
+  }
 
 protected:
   virtual T* create(uint64_t index) override
   {
-    auto item = new T(numLayers_);
+    auto item = arenaNew<T>(arena_, numLayers_, arena_);
     blockInitializer_->initCodeBlock(item, index);
     return item;
   }
+  virtual void destroy(T* item) override
+  {
+    arenaDelete(arena_, item);
+  }
 
 private:
   P* blockInitializer_;
   uint16_t numLayers_;
+  Arena* arena_;
 };
 
 struct PrecinctImpl
 {
-  PrecinctImpl(bool isCompressor, grk_rect32* bounds, grk_pt32 cblk_expn);
+  PrecinctImpl(bool isCompressor, grk_rect32* bounds, grk_pt32 cblk_expn, Arena* arena);
   ~PrecinctImpl(void);
   grk_rect32 getCodeBlockBounds(uint64_t cblkno);
   bool initCodeBlocks(uint16_t numLayers, grk_rect32* bounds);
@@ -57,6 +66,7 @@ struct PrecinctImpl
   grk_rect32 bounds_;
   grk_pt32 cblk_expn_;
   bool isCompressor_;
+  Arena* arena_;
 
 private:
   TagTreeU16* incltree; /* inclusion tree */
@@ -79,10 +89,12 @@ struct Precinct : public grk_rect32
   DecompressCodeblock* tryGetDecompressedBlockPtr(uint64_t cblkno);
   grk_pt32 getCblkExpn(void);
   grk_rect32 getCblkGrid(void);
+  Arena* getArena(void);
   uint64_t precinctIndex;
   uint16_t numLayers_;
 
 private:
+  Arena* arena_;
   PrecinctImpl* impl;
   grk_pt32 cblk_expn_;
   PrecinctImpl* getImpl(void)
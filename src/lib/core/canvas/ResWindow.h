@@ -70,7 +70,7 @@ struct ResWindow
 {
   friend struct TileComponentWindowBase<T>;
   friend struct TileComponentWindow<T>;
-  typedef grk_buf2d<T, AllocatorAligned> Buf2dAligned;
+  typedef grk_buf2d<T, AllocatorPooled> Buf2dAligned;
 
 private:
   ResWindow(uint8_t numresolutions, uint8_t resno, Buf2dAligned* resWindowHighestResREL,
@@ -373,6 +373,27 @@ private:
   {
     return resWindowBufferREL_;
   }
+  /**
+   * Get number of bytes allocated by this resolution's buffers.
+   * Buffers attached to other buffers, such as the highest resolution window, are not counted
+   */
+  uint64_t allocatedBytes(void) const
+  {
+    uint64_t rc = resWindowBuffer_->allocatedBytes() + resWindowBufferREL_->allocatedBytes();
+    for(uint8_t i = 0; i < SPLIT_NUM_ORIENTATIONS; ++i)
+    {
+      if(resWindowBufferSplit_[i])
+        rc += resWindowBufferSplit_[i]->allocatedBytes();
+      if(resWindowBufferSplitREL_[i])
+        rc += resWindowBufferSplitREL_[i]->allocatedBytes();
+    }
+    for(auto& b : bandWindowsBuffersPadded_)
+      rc += b->allocatedBytes();
+    for(auto& b : bandWindowsBuffersPaddedREL_)
+      rc += b->allocatedBytes();
+
+    return rc;
+  }
   bool allocated_;
   uint32_t filterWidth_;
 
@@ -51,28 +51,37 @@ public:
                      const uint32_t srcChunkX) = 0;
 
   virtual bool alloc(grk_rect32 window, bool zeroOutBuffer) = 0;
+  /**
+   * Get number of bytes held by allocated blocks
+   */
+  virtual uint64_t allocatedBytes(void) const = 0;
 };
 struct SparseBlock
 {
-  SparseBlock(void) : data(nullptr) {}
+  SparseBlock(void) : data(nullptr), area(0) {}
   ~SparseBlock()
   {
-    delete[] data;
+    BufferPool::get().release(data, area * sizeof(int32_t));
   }
   void alloc(uint32_t block_area, bool zeroOutBuffer)
   {
-    data = new int32_t[block_area];
+    area = block_area;
+    data = (int32_t*)BufferPool::get().acquire(area * sizeof(int32_t));
+    if(!data)
+      throw std::bad_alloc();
     if(zeroOutBuffer)
-      memset(data, 0, block_area * sizeof(int32_t));
+      memset(data, 0, area * sizeof(int32_t));
   }
   int32_t* data;
+  uint32_t area;
 };
 template<uint32_t LBW, uint32_t LBH>
 class SparseCanvas : public ISparseCanvas
 {
 public:
   SparseCanvas(grk_rect32 bds)
-      : blockWidth(1 << LBW), blockHeight(1 << LBH), blocks(nullptr), bounds(bds)
+      : blockWidth(1 << LBW), blockHeight(1 << LBH), blocks(nullptr), numAllocatedBlocks(0),
+        bounds(bds)
   {
     if(!bounds.width() || !bounds.height() || !LBW || !LBH)
       throw std::runtime_error("invalid window for sparse canvas");
@@ -137,11 +146,16 @@ public:
           assert(b->data);
           uint64_t blockInd = (uint64_t)(gridY - grid.y0) * grid.width() + (gridX - grid.x0);
           blocks[blockInd] = b;
+          numAllocatedBlocks++;
         }
       }
     }
     return true;
   }
+  uint64_t allocatedBytes(void) const
+  {
+    return numAllocatedBlocks * blockWidth * blockHeight * sizeof(int32_t);
+  }
 
 private:
   inline SparseBlock* getBlock(uint32_t block_x, uint32_t block_y)
@@ -266,6 +280,7 @@ private:
   const uint32_t blockWidth;
   const uint32_t blockHeight;
   SparseBlock** blocks;
+  uint64_t numAllocatedBlocks;
   grk_rect32 bounds; // canvas bounds
   grk_rect32 grid; // block grid bounds
 };
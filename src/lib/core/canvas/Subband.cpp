@@ -79,7 +79,7 @@ Precinct* Subband::createPrecinct(TileProcessor* tileProcessor, uint64_t precinc
     grklog.error("createPrecinct: invalid precinct bounds.");
     return nullptr;
   }
-  auto currPrec = new Precinct(tileProcessor, bounds, cblk_expn);
+  auto currPrec = arenaNew<Precinct>(tileProcessor->getArena(), tileProcessor, bounds, cblk_expn);
   currPrec->precinctIndex = precinctIndex;
   precincts.push_back(currPrec);
   precinctMap[precinctIndex] = precincts.size() - 1;
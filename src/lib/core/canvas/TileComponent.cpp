@@ -48,7 +48,7 @@ TileComponent::~TileComponent()
       {
         auto band = res->tileBand + bandIndex;
         for(auto prc : band->precincts)
-          delete prc;
+          arenaDelete(prc->getArena(), prc);
         band->precincts.clear();
       }
     }
@@ -344,6 +344,14 @@ ISparseCanvas* TileComponent::getRegionWindow()
 {
   return regionWindow_;
 }
+uint64_t TileComponent::getAllocatedBytes(void) const
+{
+  uint64_t rc = window_ ? window_->allocatedBytes() : 0;
+  if(regionWindow_)
+    rc += regionWindow_->allocatedBytes();
+
+  return rc;
+}
 void TileComponent::postProcess(int32_t* srcData, DecompressBlockExec* block)
 {
   if(block->roishift)
@@ -378,6 +386,75 @@ void TileComponent::postProcessHT(int32_t* srcData, DecompressBlockExec* block,
       postDecompressImpl<ojph::ScaleOJPHFilter<int32_t>>(srcData, block, stride);
   }
 }
+int32_t* TileComponent::getDirectDest(DecompressBlockExec* block, uint32_t& stride)
+{
+  if(regionWindow_ || !wholeTileDecompress)
+    return nullptr;
+  auto dest = window_->getCodeBlockDestWindowREL(block->resno, block->bandOrientation);
+  if(!dest || !dest->getBuffer())
+    return nullptr;
+  auto cblk = block->cblk;
+  uint32_t x = block->x;
+  uint32_t y = block->y;
+  window_->toRelativeCoordinates(block->resno, block->bandOrientation, x, y);
+  auto blockBounds = grk_rect32(x, y, x + cblk->width(), y + cblk->height());
+  if(!blockBounds.isContainedIn(*dest))
+    return nullptr;
+  block->x = x;
+  block->y = y;
+  stride = dest->stride;
+
+  return dest->getBuffer() + (uint64_t)x + (uint64_t)y * stride;
+}
+void TileComponent::postProcessDirect(int32_t* dest, uint32_t stride, DecompressBlockExec* block)
+{
+  if(block->roishift)
+  {
+    if(block->qmfbid == 1)
+      postDecompressDirectImpl<RoiShiftFilter<int32_t>>(dest, stride, block);
+    else
+      postDecompressDirectImpl<RoiScaleFilter<int32_t>>(dest, stride, block);
+  }
+  else
+  {
+    if(block->qmfbid == 1)
+      postDecompressDirectImpl<ShiftFilter<int32_t>>(dest, stride, block);
+    else
+      postDecompressDirectImpl<ScaleFilter<int32_t>>(dest, stride, block);
+  }
+}
+void TileComponent::postProcessDirectHT(int32_t* dest, uint32_t stride,
+                                        DecompressBlockExec* block)
+{
+  if(block->roishift)
+  {
+    if(block->qmfbid == 1)
+      postDecompressDirectImpl<ojph::RoiShiftOJPHFilter<int32_t>>(dest, stride, block);
+    else
+      postDecompressDirectImpl<ojph::RoiScaleOJPHFilter<int32_t>>(dest, stride, block);
+  }
+  else
+  {
+    if(block->qmfbid == 1)
+      postDecompressDirectImpl<ojph::ShiftOJPHFilter<int32_t>>(dest, stride, block);
+    else
+      postDecompressDirectImpl<ojph::ScaleOJPHFilter<int32_t>>(dest, stride, block);
+  }
+}
+// filters are applied in place, as each sample is read before it is overwritten
+template<typename F>
+void TileComponent::postDecompressDirectImpl(int32_t* dest, uint32_t stride,
+                                             DecompressBlockExec* block)
+{
+  auto cblk = block->cblk;
+  F filter(block);
+  uint32_t w = cblk->width();
+  for(uint32_t j = 0; j < cblk->height(); ++j)
+  {
+    filter.copy(dest, dest, w);
+    dest += stride;
+  }
+}
 template<typename F>
 void TileComponent::postDecompressImpl(int32_t* srcData, DecompressBlockExec* block,
                                        uint16_t stride)
@@ -387,7 +464,7 @@ void TileComponent::postDecompressImpl(int32_t* srcData, DecompressBlockExec* bl
 
   window_->toRelativeCoordinates(block->resno, block->bandOrientation, block->x, block->y);
   auto src =
-      grk_buf2d<int32_t, AllocatorAligned>(srcData, false, cblk->width(), stride, cblk->height());
+      grk_buf2d<int32_t, AllocatorPooled>(srcData, false, cblk->width(), stride, cblk->height());
   auto blockBounds =
       grk_rect32(block->x, block->y, block->x + cblk->width(), block->y + cblk->height());
   if(!empty)
@@ -39,8 +39,26 @@ struct TileComponent : public grk_rect32
   TileComponentWindow<int32_t>* getWindow() const;
   bool isWholeTileDecoding();
   ISparseCanvas* getRegionWindow();
+  /**
+   * Get number of bytes held by window and region window buffers
+   */
+  uint64_t getAllocatedBytes(void) const;
   void postProcess(int32_t* srcData, DecompressBlockExec* block);
   void postProcessHT(int32_t* srcData, DecompressBlockExec* block, uint16_t stride);
+  /**
+   * Gets location of code block in tile component window, if block
+   * can be decompressed directly into window, i.e. whole tile is being
+   * decompressed and block lies entirely inside its band window.
+   * On success, block coordinates are converted to relative coordinates
+   *
+   * @param block code block
+   * @param stride set to window stride
+   * @return pointer to top left hand corner of block in window, or nullptr
+   * if block must be decompressed into a scratch buffer and then copied
+   */
+  int32_t* getDirectDest(DecompressBlockExec* block, uint32_t& stride);
+  void postProcessDirect(int32_t* dest, uint32_t stride, DecompressBlockExec* block);
+  void postProcessDirectHT(int32_t* dest, uint32_t stride, DecompressBlockExec* block);
 
   Resolution* resolutions_; // in canvas coordinates
   uint8_t numresolutions;
@@ -52,6 +70,8 @@ struct TileComponent : public grk_rect32
 private:
   template<typename F>
   void postDecompressImpl(int32_t* srcData, DecompressBlockExec* block, uint16_t stride);
+  template<typename F>
+  void postDecompressDirectImpl(int32_t* dest, uint32_t stride, DecompressBlockExec* block);
   ISparseCanvas* regionWindow_;
   bool wholeTileDecompress;
   bool isCompressor_;
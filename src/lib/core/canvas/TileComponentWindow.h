@@ -135,6 +135,17 @@ struct TileComponentWindowBase
 
     return true;
   }
+  /**
+   * Get number of bytes allocated by all resolution buffers
+   */
+  uint64_t allocatedBytes() const
+  {
+    uint64_t rc = 0;
+    for(auto& b : resWindows)
+      rc += b->allocatedBytes();
+
+    return rc;
+  }
 
 protected:
   bool useBandWindows() const
@@ -158,7 +169,7 @@ protected:
 template<typename T>
 struct TileComponentWindow : public TileComponentWindowBase<T>
 {
-  typedef grk_buf2d<T, AllocatorAligned> Buf2dAligned;
+  typedef grk_buf2d<T, AllocatorPooled> Buf2dAligned;
   TileComponentWindow(bool isCompressor, bool lossless, bool wholeTileDecompress,
                       grk_rect32 unreducedTileComp, grk_rect32 reducedTileComp,
                       grk_rect32 unreducedImageCompWindow, uint8_t numresolutions,
@@ -210,7 +221,7 @@ struct TileComponentWindow : public TileComponentWindowBase<T>
   void postProcess(Buf2dAligned& src, uint8_t resno, eBandOrientation bandOrientation,
                    DecompressBlockExec* block)
   {
-    grk_buf2d<int32_t, AllocatorAligned> dst;
+    grk_buf2d<int32_t, AllocatorPooled> dst;
     dst = getCodeBlockDestWindowREL(resno, bandOrientation);
     dst.copyFrom<F>(src, F(block));
   }
@@ -396,7 +407,6 @@ struct TileComponentWindow : public TileComponentWindowBase<T>
     getResWindowBufferHighestREL()->transfer(buffer, stride);
   }
 
-private:
   /**
    * Get code block destination window
    *
@@ -409,6 +419,8 @@ private:
     return (useBufferCoordinatesForCodeblock()) ? getResWindowBufferHighestREL()
                                                 : getBandWindowBufferPaddedREL(resno, orientation);
   }
+
+private:
   /**
    * Get highest resolution window
    *
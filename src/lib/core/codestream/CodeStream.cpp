@@ -36,6 +36,14 @@ CodingParams* CodeStream::getCodingParams(void)
 {
   return &cp_;
 }
+ArenaPool* CodeStream::getArenaPool(void)
+{
+  return &arenaPool_;
+}
+MemoryTracker* CodeStream::getMemoryTracker(void)
+{
+  return &memTracker_;
+}
 GrkImage* CodeStream::getHeaderImage(void)
 {
   return headerImage_;
@@ -109,6 +109,7 @@ struct ICodeStreamCompress
   virtual bool init(grk_cparameters* p_param, GrkImage* p_image) = 0;
   virtual bool start(void) = 0;
   virtual uint64_t compress(grk_plugin_tile* tile) = 0;
+  virtual void getMemoryStats(grk_memory_stats* stats) = 0;
 };
 
 struct ICodeStreamDecompress
@@ -116,12 +117,16 @@ struct ICodeStreamDecompress
 public:
   virtual ~ICodeStreamDecompress() = default;
   virtual bool readHeader(grk_header_info* header_info) = 0;
-  virtual GrkImage* getImage(uint16_t tile_index) = 0;
+  virtual GrkImage* getImage(uint16_t tile_index, bool wait) = 0;
   virtual GrkImage* getImage(void) = 0;
-  virtual void init(grk_decompress_core_params* p_param) = 0;
+  virtual void init(grk_decompress_parameters* param, grk_object* codec) = 0;
   virtual bool setDecompressRegion(grk_rect_double region) = 0;
+  virtual void setDecompressBuffer(const grk_decompress_buffer* buffer) = 0;
   virtual bool decompress(grk_plugin_tile* tile) = 0;
+  virtual void wait(grk_wait_swath* swath) = 0;
   virtual bool decompressTile(uint16_t tile_index) = 0;
+  virtual void getTileCacheStats(grk_tile_cache_stats* stats) = 0;
+  virtual void getMemoryStats(grk_memory_stats* stats) = 0;
   virtual bool preProcess(void) = 0;
   virtual bool postProcess(void) = 0;
   virtual void dump(uint32_t flag, FILE* outputFileStream) = 0;
@@ -140,6 +145,8 @@ public:
   GrkImage* getHeaderImage(void);
   grk_plugin_tile* getCurrentPluginTile();
   CodingParams* getCodingParams(void);
+  ArenaPool* getArenaPool(void);
+  MemoryTracker* getMemoryTracker(void);
   static std::string markerString(uint16_t marker);
 
 protected:
@@ -155,6 +162,10 @@ protected:
   BufferedStream* stream_;
   std::map<uint32_t, TileProcessor*> processors_;
   grk_plugin_tile* current_plugin_tile;
+  // arenas for per-tile decompress structures, shared by all tile processors
+  ArenaPool arenaPool_;
+  // bytes held by this code stream, by category
+  MemoryTracker memTracker_;
 };
 
 /** @name Exported functions */
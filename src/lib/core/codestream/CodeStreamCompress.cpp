@@ -147,6 +147,11 @@ bool CodeStreamCompress::init(grk_cparameters* parameters, GrkImage* image)
       grklog.error("Invalid component precision of 0 found while setting up JP2 compressor");
       return false;
     }
+    if(comp->data_type != GRK_INT_32)
+    {
+      grklog.error("Only 32 bit integer component data is supported by the JP2 compressor");
+      return false;
+    }
   }
   if(parameters->apply_icc)
     image->applyICC();
@@ -304,6 +309,7 @@ bool CodeStreamCompress::init(grk_cparameters* parameters, GrkImage* image)
   cp_.coding_params_.enc_.allocationByFixedQuality_ = parameters->allocation_by_quality;
   cp_.coding_params_.enc_.write_plt = parameters->write_plt;
   cp_.coding_params_.enc_.write_tlm = parameters->write_tlm;
+  cp_.coding_params_.enc_.maxTilesInFlight_ = parameters->max_tiles_in_flight;
   cp_.coding_params_.enc_.rate_control_algorithm = parameters->rate_control_algorithm;
 
   /* tiles */
@@ -606,7 +612,6 @@ bool CodeStreamCompress::init(grk_cparameters* parameters, GrkImage* image)
 }
 uint64_t CodeStreamCompress::compress(grk_plugin_tile* tile)
 {
-  MinHeapPtr<TileProcessor, uint16_t, MinHeapLocker> heap;
   uint32_t numTiles = (uint32_t)cp_.t_grid_height * cp_.t_grid_width;
   if(numTiles > maxNumTilesJ2K)
   {
@@ -617,30 +622,10 @@ uint64_t CodeStreamCompress::compress(grk_plugin_tile* tile)
   }
   auto numRequiredThreads =
       std::min<uint32_t>((uint32_t)ExecSingleton::get().num_workers(), numTiles);
-  std::atomic<bool> success(true);
+  bool success = true;
   if(numRequiredThreads > 1)
   {
-    tf::Executor exec(numRequiredThreads);
-    tf::Taskflow taskflow;
-    auto node = new tf::Task[numTiles];
-    for(uint64_t i = 0; i < numTiles; i++)
-      node[i] = taskflow.placeholder();
-    for(uint16_t j = 0; j < numTiles; ++j)
-    {
-      uint16_t tile_index = j;
-      node[j].work([this, tile, tile_index, &heap, &success] {
-        if(success)
-        {
-          auto tileProcessor = new TileProcessor(tile_index, this, stream_, true);
-          tileProcessor->current_plugin_tile = tile;
-          if(!tileProcessor->preCompressTile() || !tileProcessor->doCompress())
-            success = false;
-          heap.push(tileProcessor);
-        }
-      });
-    }
-    exec.run(taskflow).wait();
-    delete[] node;
+    success = compressTiles(tile, numTiles);
   }
   else
   {
@@ -652,34 +637,133 @@ uint64_t CodeStreamCompress::compress(grk_plugin_tile* tile)
       {
         delete tileProcessor;
         success = false;
-        goto cleanup;
+        break;
       }
       bool write_success = writeTileParts(tileProcessor);
       delete tileProcessor;
       if(!write_success)
       {
         success = false;
-        goto cleanup;
+        break;
       }
     }
   }
-cleanup:
-  auto completeTileProcessor = heap.pop();
-  while(completeTileProcessor)
-  {
-    if(success)
-    {
-      if(!writeTileParts(completeTileProcessor))
-        success = false;
-    }
-    delete completeTileProcessor;
-    completeTileProcessor = heap.pop();
-  }
   if(success)
     success = end();
 
   return success ? stream_->tell() : 0;
 }
+void CodeStreamCompress::getMemoryStats(grk_memory_stats* stats)
+{
+  memTracker_.getStats(stats);
+}
+bool CodeStreamCompress::compressTiles(grk_plugin_tile* tile, uint32_t numTiles)
+{
+  auto& executor = ExecSingleton::get();
+  uint32_t window = cp_.coding_params_.enc_.maxTilesInFlight_;
+  if(!window)
+    window = (uint32_t)executor.num_workers();
+
+  // state shared with compress tasks. Each task holds a reference to the state,
+  // so nothing a task touches lives in this stack frame
+  struct TileWindow : public std::enable_shared_from_this<TileWindow>
+  {
+    TileWindow(CodeStreamCompress* codeStream, grk_plugin_tile* tile, uint32_t numTiles,
+               uint32_t window)
+        : codeStream_(codeStream), tile_(tile), numTiles_(numTiles), window_(window)
+    {}
+    // admit tiles while window has free slots. Must be called with lock held
+    void admit(void)
+    {
+      while(success_ && nextTile_ < numTiles_ && nextTile_ < numWritten_ + window_)
+      {
+        auto tileIndex = (uint16_t)nextTile_++;
+        numActive_++;
+        ExecSingleton::get().silent_async(
+            [self = shared_from_this(), tileIndex] { self->compress(tileIndex); });
+      }
+    }
+    void compress(uint16_t tileIndex)
+    {
+      auto tileProcessor = new TileProcessor(tileIndex, codeStream_, codeStream_->stream_, true);
+      tileProcessor->current_plugin_tile = tile_;
+      bool rc = tileProcessor->preCompressTile() && tileProcessor->doCompress();
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      if(!rc)
+        success_ = false;
+      completed_.push(tileProcessor);
+      // only one task writes at a time. Tiles completed by other tasks while
+      // the stream is being written are picked up by the writing task
+      if(!writing_)
+      {
+        writing_ = true;
+        std::vector<TileProcessor*> ready;
+        while(true)
+        {
+          while((tileProcessor = completed_.pop()) != nullptr)
+            ready.push_back(tileProcessor);
+          if(ready.empty())
+            break;
+          bool writeSuccess = success_;
+          lock.unlock();
+          for(auto tp : ready)
+          {
+            if(writeSuccess && !codeStream_->writeTileParts(tp))
+              writeSuccess = false;
+            delete tp;
+          }
+          lock.lock();
+          if(!writeSuccess)
+            success_ = false;
+          numWritten_ += (uint32_t)ready.size();
+          ready.clear();
+          admit();
+        }
+        writing_ = false;
+      }
+      // last access to shared state: once no tiles are active, the waiter may return
+      numActive_--;
+      completeCondition_.notify_all();
+    }
+
+    CodeStreamCompress* codeStream_;
+    grk_plugin_tile* tile_;
+    uint32_t numTiles_;
+    uint32_t window_;
+    // all members below are guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable completeCondition_;
+    MinHeapPtr<TileProcessor, uint16_t, MinHeapFakeLocker> completed_;
+    uint32_t nextTile_ = 0;
+    uint32_t numWritten_ = 0;
+    uint32_t numActive_ = 0;
+    bool writing_ = false;
+    bool success_ = true;
+  };
+  auto state = std::make_shared<TileWindow>(this, tile, numTiles, window);
+  {
+    std::lock_guard<std::mutex> lock(state->mutex_);
+    state->admit();
+  }
+  // admitted tiles are contiguous and all of them are pushed on completion,
+  // so once no tiles are active, every admitted tile has been written and released
+  if(executor.this_worker_id() >= 0)
+  {
+    executor.corun_until([&state] {
+      std::lock_guard<std::mutex> lock(state->mutex_);
+      return state->numActive_ == 0;
+    });
+  }
+  else
+  {
+    std::unique_lock<std::mutex> lock(state->mutex_);
+    state->completeCondition_.wait(lock, [&state] { return state->numActive_ == 0; });
+  }
+  std::lock_guard<std::mutex> lock(state->mutex_);
+
+  return state->success_;
+}
 bool CodeStreamCompress::end(void)
 {
   /* customization of the compressing */
@@ -37,11 +37,23 @@ public:
   bool start(void);
   bool init(grk_cparameters* p_param, GrkImage* p_image);
   uint64_t compress(grk_plugin_tile* tile);
+  void getMemoryStats(grk_memory_stats* stats);
 
 private:
   bool init_header_writing(void);
   bool cacheEndOfHeader(void);
   bool end(void);
+  /**
+   * Compresses tiles concurrently, writing each tile as soon as all preceding
+   * tiles have been written. At most max_tiles_in_flight tiles are admitted
+   * at any one time, so that peak memory scales with this window rather than
+   * with the number of tiles in the image
+   *
+   * @param tile plugin tile
+   * @param numTiles number of tiles in image
+   * @return true if successful
+   */
+  bool compressTiles(grk_plugin_tile* tile, uint32_t numTiles);
   bool writeTilePart(TileProcessor* tileProcessor);
   bool writeTileParts(TileProcessor* tileProcessor);
   bool updateRates(void);
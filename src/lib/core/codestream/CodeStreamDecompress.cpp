@@ -24,10 +24,13 @@
 namespace grk
 {
 CodeStreamDecompress::CodeStreamDecompress(BufferedStream* stream)
-    : CodeStream(stream), expectSOD_(false), curr_marker_(0), headerError_(false),
-      headerRead_(false), marker_scratch_(nullptr), marker_scratch_size_(0), outputImage_(nullptr),
-      tileCache_(new TileCache()), ioBufferCallback(nullptr), ioUserData(nullptr),
-      grkRegisterReclaimCallback_(nullptr)
+    : CodeStream(stream), expectSOD_(false), deferTilePartReads_(false), curr_marker_(0),
+      headerError_(false), headerRead_(false), marker_scratch_(nullptr), marker_scratch_size_(0),
+      outputImage_(nullptr), tileCache_(new TileCache(&memTracker_)), outputDataType_(GRK_INT_32),
+      decompressBuffer_{}, ioBufferCallback(nullptr), ioUserData(nullptr),
+      grkRegisterReclaimCallback_(nullptr), buildingIndex_(false), cacheIndex_(false),
+      asynchronous_(false), simulateSynchronous_(false), decompressCallback_(nullptr),
+      decompressCallbackUserData_(nullptr), codec_(nullptr), asyncSuccess_(true)
 {
   decompressorState_.default_tcp_ = new TileCodingParams();
   decompressorState_.lastSotReadPosition = 0;
@@ -100,6 +103,7 @@ CodeStreamDecompress::CodeStreamDecompress(BufferedStream* stream)
 }
 CodeStreamDecompress::~CodeStreamDecompress()
 {
+  joinDecompressWorker();
   for(const auto& val : marker_map)
     delete val.second;
   delete decompressorState_.default_tcp_;
@@ -150,10 +154,45 @@ DecompressorState* CodeStreamDecompress::getDecompressorState(void)
 {
   return &decompressorState_;
 }
-GrkImage* CodeStreamDecompress::getImage(uint16_t tile_index)
+GrkImage* CodeStreamDecompress::getImage(uint16_t tile_index, bool wait)
 {
-  auto entry = tileCache_->get(tile_index);
-  return entry ? entry->processor->getImage() : nullptr;
+  if(wait)
+    decompressorState_.tilesToDecompress_.waitForDecoded(tile_index);
+  // only decoded tiles of multi-tile images are cached with the image strategy
+  if(!decompressorState_.tilesToDecompress_.isDecoded(tile_index) || !outputImage_ ||
+     !outputImage_->has_multiple_tiles || !(tileCache_->getStrategy() & GRK_TILE_CACHE_IMAGE))
+    return tileCache_->getImage(tile_index);
+  // tile may be evicted between hit and getImage by an asynchronous decompression
+  auto image = tileCache_->hit(tile_index) ? tileCache_->getImage(tile_index) : nullptr;
+  if(image)
+    return image;
+
+  // tile has been evicted from the cache
+  return redecompressTile(tile_index);
+}
+GrkImage* CodeStreamDecompress::redecompressTile(uint16_t tile_index)
+{
+  // asynchronous decompression shares the stream and admits tiles to the cache
+  joinDecompressWorker();
+  auto tcp = cp_.tcps + tile_index;
+  // rewind packed packet headers consumed by the first decompression
+  if(tcp->ppt)
+  {
+    tcp->ppt_data = tcp->ppt_buffer;
+    tcp->ppt_len = tcp->ppt_data_size;
+  }
+  auto processor = new TileProcessor(tile_index, this, stream_, false);
+  tileCache_->put(tile_index, processor);
+  if(!processor->init() || !processor->decompressT2T1(outputImage_))
+  {
+    grklog.error("Failed to decompress evicted tile %u", tile_index);
+    processor->release(GRK_TILE_CACHE_NONE);
+    return nullptr;
+  }
+  processor->release(tileCache_->getStrategy());
+  tileCache_->admit(tile_index);
+
+  return tileCache_->getImage(tile_index);
 }
 std::vector<GrkImage*> CodeStreamDecompress::getAllImages(void)
 {
@@ -178,15 +217,16 @@ bool CodeStreamDecompress::readHeader(grk_header_info* header_info)
     }
     headerRead_ = true;
     procedure_list_.push_back(std::bind(&CodeStreamDecompress::readHeaderProcedure, this));
-    procedure_list_.push_back(std::bind(&CodeStreamDecompress::copy_default_tcp, this));
     if(!exec(procedure_list_))
     {
       headerError_ = true;
       return false;
     }
+    initIndex();
     if(header_info)
       headerImage_->has_multiple_tiles =
           headerImage_->has_multiple_tiles && !header_info->single_tile_decompress;
+    headerImage_->decompress_data_type = outputDataType_;
     auto composite = getCompositeImage();
     headerImage_->copyHeader(composite);
     if(header_info)
@@ -241,6 +281,13 @@ bool CodeStreamDecompress::readHeader(grk_header_info* header_info)
   }
   return true;
 }
+void CodeStreamDecompress::setDecompressBuffer(const grk_decompress_buffer* buffer)
+{
+  if(buffer)
+    decompressBuffer_ = *buffer;
+  else
+    decompressBuffer_ = {};
+}
 bool CodeStreamDecompress::setDecompressRegion(grk_rect_double region)
 {
   auto image = headerImage_;
@@ -350,33 +397,109 @@ bool CodeStreamDecompress::setDecompressRegion(grk_rect_double region)
 
   return true;
 }
-void CodeStreamDecompress::init(grk_decompress_core_params* parameters)
+void CodeStreamDecompress::init(grk_decompress_parameters* param, grk_object* codec)
 {
-  assert(parameters);
+  assert(param);
+  auto parameters = &param->core;
 
   cp_.coding_params_.dec_.layers_to_decompress_ = parameters->layers_to_decompress;
   cp_.coding_params_.dec_.reduce_ = parameters->reduce;
   cp_.coding_params_.dec_.disable_random_access_flags_ = parameters->disable_random_access_flags;
   tileCache_->setStrategy(parameters->tile_cache_strategy);
+  tileCache_->setMaxBytes(parameters->tile_cache_max_bytes);
+  memTracker_.setBudget(parameters->memory_budget);
+  outputDataType_ = parameters->output_data_type;
 
   ioBufferCallback = parameters->io_buffer_callback;
   ioUserData = parameters->io_user_data;
   grkRegisterReclaimCallback_ = parameters->io_register_client_callback;
+  indexFile_ = parameters->index_file ? parameters->index_file : "";
+  cacheIndex_ = parameters->cache_index;
+
+  asynchronous_ = param->asynchronous;
+  simulateSynchronous_ = param->simulate_synchronous;
+  decompressCallback_ = param->decompress_callback;
+  decompressCallbackUserData_ = param->decompress_callback_user_data;
+  codec_ = codec;
 }
 bool CodeStreamDecompress::decompress(grk_plugin_tile* tile)
 {
+  // only one decompression may be in flight at a time
+  joinDecompressWorker();
+
   procedure_list_.push_back(std::bind(&CodeStreamDecompress::decompressTiles, this));
   current_plugin_tile = tile;
+  auto tiles = &decompressorState_.tilesToDecompress_;
+  tiles->resetDecoded();
+  if(!asynchronous_)
+  {
+    bool rc = decompressExec() && postProcess();
+    tiles->setAllDecoded();
 
-  return decompressExec();
+    return rc;
+  }
+  asyncSuccess_ = true;
+  decompressWorker_ = std::thread([this, tiles] {
+    asyncSuccess_ = decompressExec() && postProcess();
+    if(!asyncSuccess_)
+      grklog.error("Asynchronous decompression failed");
+    tiles->setAllDecoded();
+  });
+  if(simulateSynchronous_)
+  {
+    joinDecompressWorker();
+    return asyncSuccess_;
+  }
+
+  return true;
+}
+void CodeStreamDecompress::wait(grk_wait_swath* swath)
+{
+  auto tiles = &decompressorState_.tilesToDecompress_;
+  if(!swath)
+  {
+    tiles->waitForAllDecoded();
+    return;
+  }
+  // map swath (in reduced canvas coordinates) to tile grid
+  auto reduce = cp_.coding_params_.dec_.reduce_;
+  auto tileCoord = [reduce](uint32_t pixel, uint32_t origin, uint32_t tileDim, uint16_t gridDim,
+                            bool roundUp) {
+    uint64_t full = (uint64_t)pixel << reduce;
+    if(full <= origin)
+      return (uint16_t)0;
+    uint64_t t = roundUp ? (full - origin + tileDim - 1) / tileDim : (full - origin) / tileDim;
+    return (uint16_t)std::min<uint64_t>(t, gridDim);
+  };
+  swath->tile_x0 = tileCoord(swath->x0, cp_.tx0, cp_.t_width, cp_.t_grid_width, false);
+  swath->tile_y0 = tileCoord(swath->y0, cp_.ty0, cp_.t_height, cp_.t_grid_height, false);
+  swath->tile_x1 = tileCoord(swath->x1, cp_.tx0, cp_.t_width, cp_.t_grid_width, true);
+  swath->tile_y1 = tileCoord(swath->y1, cp_.ty0, cp_.t_height, cp_.t_grid_height, true);
+  swath->num_tile_cols = cp_.t_grid_width;
+  if(swath->tile_x0 < swath->tile_x1 && swath->tile_y0 < swath->tile_y1)
+    tiles->waitForDecoded(
+        grk_rect16(swath->tile_x0, swath->tile_y0, swath->tile_x1, swath->tile_y1));
+}
+void CodeStreamDecompress::joinDecompressWorker(void)
+{
+  if(decompressWorker_.joinable())
+    decompressWorker_.join();
 }
 bool CodeStreamDecompress::decompressTile(uint16_t tile_index)
 {
+  joinDecompressWorker();
+
   // 1. check if tile has already been decompressed
-  auto entry = tileCache_->get(tile_index);
-  if(entry && entry->processor && entry->processor->getImage())
+  if(tileCache_->hit(tile_index))
     return true;
 
+  // tiles are accessed out of order, so the index can't be built
+  if(buildingIndex_)
+  {
+    buildingIndex_ = false;
+    index_.reset();
+  }
+
   // 2. otherwise, decompress tile
   if(outputImage_)
   {
@@ -446,6 +569,10 @@ bool CodeStreamDecompress::decompressTile(uint16_t tile_index)
 
   return decompressExec();
 }
+bool CodeStreamDecompress::deferTilePartReads(void)
+{
+  return deferTilePartReads_;
+}
 bool CodeStreamDecompress::endOfCodeStream(void)
 {
   return decompressorState_.getState() == DECOMPRESS_STATE_EOC ||
@@ -459,27 +586,77 @@ bool CodeStreamDecompress::decompressTiles(void)
     headerError_ = true;
     return false;
   }
-  if(!createOutputImage())
+  // PPM packed packet headers are consumed by decompression, so evicted tiles
+  // could not be decompressed again
+  if(cp_.ppm_marker && tileCache_->getMaxBytes())
+  {
+    grklog.warn("Tile cache is unbounded for code streams with PPM markers");
+    tileCache_->setMaxBytes(0);
+  }
+  // asynchronous multi-tile decompression composites directly into the composite image,
+  // so that swaths are visible to the client as soon as their tiles are complete
+  if(!createOutputImage(asynchronous_ && headerImage_->has_multiple_tiles))
     return false;
 
   auto numRequiredThreads =
       std::min<uint32_t>((uint32_t)ExecSingleton::get().num_workers(), numTilesToDecompress);
   std::atomic<bool> success(true);
   std::atomic<uint32_t> numTilesDecompressed(0);
-
-  tf::Executor* executor = nullptr;
-  tf::Task* node = nullptr;
-  tf::Taskflow taskflow;
-  if(numRequiredThreads > 1)
-  {
-    executor = new tf::Executor(numRequiredThreads);
-    node = new tf::Task[numTilesToDecompress];
-    for(uint64_t i = 0; i < numTilesToDecompress; i++)
-      node[i] = taskflow.placeholder();
-  }
+  // with concurrent tile decompression, only tile part headers are read while parsing;
+  // each worker fetches its tile's data with positional reads. Zero-copy streams
+  // reference tile data in place, so there is nothing to gain for them.
+  deferTilePartReads_ =
+      numRequiredThreads > 1 && stream_->supportsReadAt() && !stream_->supportsZeroCopy();
+
+  // 3. T2 + T1 decompress
+  // once we schedule a processor for T1 compression, we will destroy it
+  // regardless of success or not.
+  // Every tile retires from the memory tracker as its last step : the scheduling thread
+  // may then return, so nothing local to this function may be touched afterwards
+  auto exec = [this, numTilesToDecompress, &numTilesDecompressed,
+               &success](TileProcessor* processor) {
+    if(!success)
+    {
+      memTracker_.retireTile(0);
+      return;
+    }
+    if(!processor->decompressT2T1(outputImage_))
+    {
+      grklog.error("Failed to decompress tile %u/%u", processor->getIndex(),
+                   numTilesToDecompress);
+      success = false;
+      memTracker_.retireTile(processor->getMemoryFootprint());
+      return;
+    }
+    numTilesDecompressed++;
+    if(buildingIndex_ && !processor->packetLengths_.empty())
+      index_->setPacketLengths(processor->getIndex(), std::move(processor->packetLengths_));
+    auto img = processor->getImage();
+    if(outputImage_->has_multiple_tiles && img)
+    {
+      if(!outputImage_->composite(img))
+        success = false;
+    }
+    auto tileIndex = processor->getIndex();
+    if(success)
+    {
+      if(decompressCallback_)
+        decompressCallback_(codec_, tileIndex, img, cp_.coding_params_.dec_.reduce_,
+                            decompressCallbackUserData_);
+      // single tile images only become visible once data is transferred to the composite
+      if(outputImage_->has_multiple_tiles)
+        decompressorState_.tilesToDecompress_.setDecoded(tileIndex);
+    }
+    processor->release(success ? tileCache_->getStrategy() : GRK_TILE_CACHE_NONE);
+    auto footprint = processor->getMemoryFootprint();
+    // admission may evict least recently used tiles, including this one
+    if(success)
+      tileCache_->admit(tileIndex);
+    memTracker_.retireTile(footprint);
+  };
+  std::vector<TileProcessor*> parsedTiles;
   bool breakAfterT1 = false;
   bool canDecompress = true;
-  uint16_t tileCount = 0;
   while(!endOfCodeStream() && !breakAfterT1)
   {
     // 1. parse tile
@@ -522,37 +699,12 @@ bool CodeStreamDecompress::decompressTiles(void)
     {
       breakAfterT1 = true;
     }
-    // 3. T2 + T1 decompress
-    // once we schedule a processor for T1 compression, we will destroy it
-    // regardless of success or not
-    auto exec = [this, processor, numTilesToDecompress, &numTilesDecompressed, &success] {
-      if(success)
-      {
-        if(!processor->decompressT2T1(outputImage_))
-        {
-          grklog.error("Failed to decompress tile %u/%u", processor->getIndex(),
-                       numTilesToDecompress);
-          success = false;
-        }
-        else
-        {
-          numTilesDecompressed++;
-          auto img = processor->getImage();
-          if(outputImage_->has_multiple_tiles && img)
-          {
-            if(!outputImage_->composite(img))
-              success = false;
-          }
-          processor->release(success ? tileCache_->getStrategy() : GRK_TILE_CACHE_NONE);
-        }
-      }
-      return 0;
-    };
-    if(node)
-      node[tileCount++].work(exec);
+    if(numRequiredThreads > 1)
+      parsedTiles.push_back(processor);
     else
     {
-      exec();
+      memTracker_.admitTile(1);
+      exec(processor);
       if(!success)
         goto cleanup;
     }
@@ -571,46 +723,36 @@ bool CodeStreamDecompress::decompressTiles(void)
       break;
     }
   }
-  if(executor)
+cleanup:
+  if(!parsedTiles.empty())
   {
-    executor->run(taskflow).wait();
-    delete executor;
-    executor = nullptr;
-    delete[] node;
-    node = nullptr;
+    // Tiles are decompressed on the shared executor, and the block and wavelet flows of a tile
+    // co-run on the same workers. Bounding the number of tiles in flight bounds the nesting
+    // depth of co-running tiles. With a memory budget, tiles are also only admitted while
+    // they fit.
+    auto& executor = ExecSingleton::get();
+    for(auto processor : parsedTiles)
+    {
+      memTracker_.admitTile(numRequiredThreads);
+      executor.silent_async([&exec, processor] { exec(processor); });
+    }
+    memTracker_.waitForTiles();
   }
-
   if(!success)
-    goto cleanup;
+    return false;
+  if(buildingIndex_)
+    finishIndex();
 
   if(numTilesDecompressed == 0)
   {
     grklog.error("No tiles were decompressed.");
-    success = false;
-    goto cleanup;
+    return false;
   }
   else if(numTilesDecompressed < numTilesToDecompress && cp_.wholeTileDecompress_)
   {
     uint32_t decompressed = numTilesDecompressed;
     grklog.warn("Only %u out of %u tiles were decompressed", decompressed, numTilesToDecompress);
   }
-cleanup:
-  if(executor)
-  {
-    executor->run(taskflow).wait();
-    delete executor;
-    delete[] node;
-  }
-  return success;
-}
-bool CodeStreamDecompress::copy_default_tcp(void)
-{
-  for(uint16_t i = 0; i < cp_.t_grid_height * cp_.t_grid_width; ++i)
-  {
-    auto tcp = cp_.tcps + i;
-    if(!tcp->copy(decompressorState_.default_tcp_, headerImage_))
-      return false;
-  }
 
   return true;
 }
@@ -751,14 +893,16 @@ bool CodeStreamDecompress::decompressExec(void)
     return false;
 
   // transfer output image to composite image
-  outputImage_->transferDataTo(getCompositeImage());
+  if(outputImage_ != getCompositeImage())
+    outputImage_->transferDataTo(getCompositeImage());
 
   return true;
 }
 
-bool CodeStreamDecompress::createOutputImage(void)
+bool CodeStreamDecompress::createOutputImage(bool compositeInPlace)
 {
-  if(!headerImage_->has_multiple_tiles)
+  auto compositeImage = getCompositeImage();
+  if(!headerImage_->has_multiple_tiles || (outputImage_ == compositeImage) != compositeInPlace)
   {
     if(outputImage_)
       grk_object_unref(&outputImage_->obj);
@@ -766,11 +910,32 @@ bool CodeStreamDecompress::createOutputImage(void)
   }
   if(!outputImage_)
   {
-    outputImage_ = new GrkImage();
-    getCompositeImage()->copyHeader(outputImage_);
+    if(compositeInPlace)
+    {
+      grk_object_ref(&compositeImage->obj);
+      outputImage_ = compositeImage;
+    }
+    else
+    {
+      outputImage_ = new GrkImage();
+      compositeImage->copyHeader(outputImage_);
+    }
   }
+  if(!outputImage_->setDecompressBuffer(decompressBuffer_.data ? &decompressBuffer_ : nullptr))
+    return false;
+  if(!outputImage_->allocCompositeData())
+    return false;
+  updateCompositeMemory();
 
-  return outputImage_->allocCompositeData();
+  return true;
+}
+void CodeStreamDecompress::updateCompositeMemory(void)
+{
+  auto compositeImage = getCompositeImage();
+  uint64_t bytes = compositeImage->getDataBytes();
+  if(outputImage_ && outputImage_ != compositeImage)
+    bytes += outputImage_->getDataBytes();
+  memTracker_.set(GRK_MEM_COMPOSITE, bytes);
 }
 
 /*
@@ -778,7 +943,7 @@ bool CodeStreamDecompress::createOutputImage(void)
  */
 bool CodeStreamDecompress::decompressTile(void)
 {
-  if(!createOutputImage())
+  if(!createOutputImage(false))
     return false;
   if(decompressorState_.tilesToDecompress_.numScheduled() != 1)
   {
@@ -797,8 +962,23 @@ bool CodeStreamDecompress::decompressTile(void)
     {
       if(!codeStreamInfo->allocTileInfo((uint16_t)(cp_.t_grid_width * cp_.t_grid_height)))
         return false;
-      if(!codeStreamInfo->seekFirstTilePart(tile_index))
+      auto indexedTilePart =
+          (index_ && !buildingIndex_) ? index_->firstTilePart(tile_index) : nullptr;
+      if(indexedTilePart && !seekToIndexedTilePart(indexedTilePart))
+      {
+        dropIndex();
+        indexedTilePart = nullptr;
+      }
+      if(indexedTilePart)
+      {
+        // stream is now just past SOT marker of first tile part for this tile
+        curr_marker_ = J2K_SOT;
+        decompressorState_.setState(DECOMPRESS_STATE_TPH_SOT);
+      }
+      else if(!codeStreamInfo->seekFirstTilePart(tile_index))
+      {
         return false;
+      }
     }
     catch(const CorruptTLMException& cte)
     {
@@ -823,6 +1003,7 @@ bool CodeStreamDecompress::decompressTile(void)
     tileProcessor = currentTileProcessor_;
     if(!tileProcessor->decompressT2T1(outputImage_))
       return false;
+    tileCache_->admit(tile_index);
 
     // check for corrupt Adobe images where a final tile part is not parsed
     // due to incorrectly-signalled number of tile parts
@@ -843,6 +1024,123 @@ bool CodeStreamDecompress::decompressTile(void)
 
   return true;
 }
+void CodeStreamDecompress::getMemoryStats(grk_memory_stats* stats)
+{
+  memTracker_.getStats(stats);
+}
+void CodeStreamDecompress::getTileCacheStats(grk_tile_cache_stats* stats)
+{
+  tileCache_->getStats(stats);
+}
+void CodeStreamDecompress::initIndex(void)
+{
+  if((indexFile_.empty() && !cacheIndex_) || !stream_->hasSeek())
+    return;
+  // source identity and main header bytes identify the code stream
+  auto& source = stream_->getIdentity();
+  if(source.empty())
+  {
+    if(!indexFile_.empty())
+      grklog.warn("Code stream index %s ignored : stream is neither a file nor a URL",
+                  indexFile_.c_str());
+    return;
+  }
+  auto mainHeaderStart = codeStreamInfo->getMainHeaderStart();
+  std::vector<uint8_t> mainHeader(codeStreamInfo->getMainHeaderEnd() - mainHeaderStart);
+  bool rc;
+  if(stream_->supportsReadAt())
+  {
+    rc = stream_->readAt(mainHeaderStart, mainHeader.data(), mainHeader.size()) ==
+         mainHeader.size();
+  }
+  else
+  {
+    auto position = stream_->tell();
+    rc = stream_->seek(mainHeaderStart) &&
+         stream_->read(mainHeader.data(), mainHeader.size()) == mainHeader.size();
+    rc = stream_->seek(position) && rc;
+  }
+  if(!rc)
+  {
+    grklog.warn("Unable to read main header for code stream index");
+    return;
+  }
+  if(cacheIndex_)
+    index_ = CodeStreamIndex::findCached(source, mainHeader);
+  if(!index_ && !indexFile_.empty())
+  {
+    auto index = CodeStreamIndex::load(indexFile_.c_str());
+    if(index && index->matches(source, mainHeader))
+    {
+      index_ = index;
+      if(cacheIndex_)
+        CodeStreamIndex::cache(index_);
+    }
+    else if(index)
+    {
+      grklog.warn("Code stream index %s does not match code stream, and will be rebuilt",
+                  indexFile_.c_str());
+    }
+  }
+  if(!index_)
+  {
+    index_ = std::make_shared<CodeStreamIndex>(
+        source, std::move(mainHeader), (uint16_t)(cp_.t_grid_width * cp_.t_grid_height));
+    buildingIndex_ = true;
+  }
+}
+bool CodeStreamDecompress::seekIndexedTilePart(void)
+{
+  auto position = stream_->tell() - MARKER_BYTES;
+  auto tilePart = index_->nextTilePart(position, &decompressorState_.tilesToDecompress_);
+  if(!tilePart || tilePart->position_ == position || seekToIndexedTilePart(tilePart))
+    return true;
+  // fall back to parsing from the current tile part
+  dropIndex();
+
+  return stream_->tell() == position + MARKER_BYTES;
+}
+bool CodeStreamDecompress::seekToIndexedTilePart(const IndexedTilePart* tilePart)
+{
+  // SOT marker, Lsot and Isot
+  uint8_t sot[6];
+  uint16_t marker = 0, Lsot = 0, Isot = 0;
+  auto position = stream_->tell();
+  if(stream_->seek(tilePart->position_) && stream_->read(sot, sizeof(sot)) == sizeof(sot))
+  {
+    grk_read(sot, &marker);
+    grk_read(sot + 2, &Lsot);
+    grk_read(sot + 4, &Isot);
+  }
+  if(marker != J2K_SOT || Lsot != sot_marker_segment_len_minus_tile_data_len - MARKER_BYTES ||
+     Isot != tilePart->tileIndex_)
+  {
+    // restore position, so that caller can parse without the index
+    stream_->seek(position);
+    return false;
+  }
+
+  return stream_->seek(tilePart->position_ + MARKER_BYTES);
+}
+void CodeStreamDecompress::dropIndex(void)
+{
+  grklog.warn("Code stream does not match code stream index : index will not be used");
+  index_.reset();
+}
+void CodeStreamDecompress::finishIndex(void)
+{
+  buildingIndex_ = false;
+  // index is only of use if every tile part has been located
+  if(!endOfCodeStream() || !index_->isComplete())
+  {
+    index_.reset();
+    return;
+  }
+  if(!indexFile_.empty() && index_->save(indexFile_.c_str()))
+    grklog.info("Wrote code stream index %s", indexFile_.c_str());
+  if(cacheIndex_)
+    CodeStreamIndex::cache(index_);
+}
 bool CodeStreamDecompress::checkForIllegalTilePart(void)
 {
   try
@@ -976,8 +1274,13 @@ bool CodeStreamDecompress::postProcess(void)
   if(!img->greyToRGB())
     return false;
   img->convertPrecision();
+  if(!img->execUpsample())
+    return false;
+  // fallback for images whose post processing needs 32 bit samples
+  bool rc = img->convertDataType();
+  updateCompositeMemory();
 
-  return img->execUpsample();
+  return rc;
 }
 
 void CodeStreamDecompress::dump_tile_info(TileCodingParams* default_tile, uint32_t numcomps,
@@ -1063,7 +1366,9 @@ void CodeStreamDecompress::dump(uint32_t flag, FILE* outputFileStream)
       for(uint16_t i = 0; i < numTiles; ++i)
       {
         auto tcp = cp->tcps + i;
-        dump_tile_info(tcp, getHeaderImage()->numcomps, outputFileStream);
+        // tiles that have not been parsed share the default coding parameters
+        dump_tile_info(tcp->initialized_ ? tcp : decompressorState_.default_tcp_,
+                       getHeaderImage()->numcomps, outputFileStream);
       }
     }
   }
@@ -1071,6 +1376,9 @@ void CodeStreamDecompress::dump(uint32_t flag, FILE* outputFileStream)
   /* Dump the code stream index from main header */
   if((flag & GRK_MH_IND) && codeStreamInfo)
     codeStreamInfo->dump(outputFileStream);
+
+  if(flag & GRK_MEM_INFO)
+    memTracker_.dump(outputFileStream);
 }
 void CodeStreamDecompress::dump_MH_info(FILE* outputFileStream)
 {
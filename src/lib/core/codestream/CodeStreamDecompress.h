@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <thread>
+
 namespace grk
 {
 typedef std::function<bool(uint8_t* headerData, uint16_t header_size)> MARKER_FUNC;
@@ -43,14 +45,29 @@ public:
   DecompressorState* getDecompressorState(void);
   TileCodingParams* get_current_decode_tcp(void);
   bool isDecodingTilePartHeader();
+  /**
+   * Check if tile part data should be left in the stream while parsing, and read
+   * later with positional reads by the worker that decompresses the tile
+   */
+  bool deferTilePartReads(void);
   bool readHeader(grk_header_info* header_info);
-  GrkImage* getImage(uint16_t tile_index);
+  GrkImage* getImage(uint16_t tile_index, bool wait);
   GrkImage* getImage(void);
   std::vector<GrkImage*> getAllImages(void);
-  void init(grk_decompress_core_params* p_param);
+  void init(grk_decompress_parameters* param, grk_object* codec);
   bool setDecompressRegion(grk_rect_double region);
+  void setDecompressBuffer(const grk_decompress_buffer* buffer);
   bool decompress(grk_plugin_tile* tile);
+  /**
+   * Wait for asynchronous decompression
+   *
+   * @param swath swath of tiles to wait for. If null, wait for entire
+   * decompression, including post processing, to complete
+   */
+  void wait(grk_wait_swath* swath);
   bool decompressTile(uint16_t tile_index);
+  void getTileCacheStats(grk_tile_cache_stats* stats);
+  void getMemoryStats(grk_memory_stats* stats);
   bool preProcess(void);
   bool postProcess(void);
   CodeStreamInfo* getCodeStreamInfo(void);
@@ -97,8 +114,13 @@ private:
   bool decompressTile();
   bool findNextSOT(TileProcessor* tileProcessor);
   bool decompressTiles(void);
+  /**
+   * Decompress a tile again, once its image has been evicted from the tile cache
+   *
+   * @return tile image, or nullptr if the tile could not be decompressed
+   */
+  GrkImage* redecompressTile(uint16_t tile_index);
   bool decompressValidation(void);
-  bool copy_default_tcp(void);
   bool read_unk(void);
   /**
     Add main header marker information
@@ -311,12 +333,43 @@ private:
    */
   const marker_handler* get_marker_handler(uint16_t id);
 
-  bool createOutputImage(void);
+  bool createOutputImage(bool compositeInPlace);
+  // charge composite and output image data to the memory tracker
+  void updateCompositeMemory(void);
+  void joinDecompressWorker(void);
   bool checkForIllegalTilePart(void);
+  /**
+   * Find code stream index after main header has been read : in the process-wide cache,
+   * or in the sidecar file. If there is no matching index, start building one
+   */
+  void initIndex(void);
+  /**
+   * Seek past SOT marker of next indexed tile part that is needed. If the code stream
+   * does not match the index at that tile part, the index is dropped, and parsing
+   * continues from the current tile part
+   */
+  bool seekIndexedTilePart(void);
+  /**
+   * Seek past SOT marker of indexed tile part, after checking that the SOT marker
+   * segment at the indexed position belongs to the indexed tile
+   *
+   * @return false if SOT marker segment does not match index, in which case
+   * the stream position is restored
+   */
+  bool seekToIndexedTilePart(const IndexedTilePart* tilePart);
+  /**
+   * Stop using index that does not match code stream
+   */
+  void dropIndex(void);
+  /**
+   * Save and cache index once the whole code stream has been parsed
+   */
+  void finishIndex(void);
 
   std::map<uint16_t, marker_handler*> marker_map;
   DecompressorState decompressorState_;
   bool expectSOD_;
+  bool deferTilePartReads_;
   uint16_t curr_marker_;
   bool headerError_;
   bool headerRead_;
@@ -324,9 +377,26 @@ private:
   uint16_t marker_scratch_size_;
   GrkImage* outputImage_;
   TileCache* tileCache_;
+  GRK_DATA_TYPE outputDataType_;
+  grk_decompress_buffer decompressBuffer_;
   grk_io_pixels_callback ioBufferCallback;
   void* ioUserData;
   grk_io_register_reclaim_callback grkRegisterReclaimCallback_;
+
+  // code stream index : used to seek to tile parts, or built while parsing
+  std::shared_ptr<CodeStreamIndex> index_;
+  bool buildingIndex_;
+  std::string indexFile_;
+  bool cacheIndex_;
+
+  // asynchronous decompression
+  bool asynchronous_;
+  bool simulateSynchronous_;
+  grk_decompress_callback decompressCallback_;
+  void* decompressCallbackUserData_;
+  grk_object* codec_;
+  std::thread decompressWorker_;
+  std::atomic<bool> asyncSuccess_;
 };
 
 } // namespace grk
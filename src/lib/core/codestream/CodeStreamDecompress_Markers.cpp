@@ -140,6 +140,9 @@ bool CodeStreamDecompress::parseTileParts(bool* canDecompress)
          !decompressorState_.tilesToDecompress_.isComplete(currentTileProcessor_->getIndex())) &&
         (curr_marker_ != J2K_EOC))
   {
+    // with a code stream index, skip straight to the next tile part that is needed
+    if(index_ && !buildingIndex_ && curr_marker_ == J2K_SOT && !seekIndexedTilePart())
+      return false;
     /* read markers until SOD is detected */
     while(curr_marker_ != J2K_SOD)
     {
@@ -179,6 +182,13 @@ bool CodeStreamDecompress::parseTileParts(bool* canDecompress)
         uint64_t sot_pos = stream_->tell() - markerSize - MARKER_PLUS_MARKER_LENGTH_BYTES;
         if(sot_pos > decompressorState_.lastSotReadPosition)
           decompressorState_.lastSotReadPosition = sot_pos;
+        if(buildingIndex_)
+          index_->pushTilePart(currentTileProcessor_->getIndex(), sot_pos,
+                               currentTileProcessor_->getTilePartDataLength() +
+                                   sot_marker_segment_len_minus_tile_data_len);
+        // every tile part reached, whether by seeking or parsing, must be indexed
+        else if(index_ && !index_->hasTilePart(currentTileProcessor_->getIndex(), sot_pos))
+          dropIndex();
         // skip over data to beginning of next tile part if we are not interested in this
         // one
         if(!decompressorState_.tilesToDecompress_.isScheduled(currentTileProcessor_->getIndex()))
@@ -191,6 +201,9 @@ bool CodeStreamDecompress::parseTileParts(bool* canDecompress)
           expectSOD_ = false;
           break;
         }
+        if(!(cp_.tcps + currentTileProcessor_->getIndex())
+                ->initFromDefault(decompressorState_.default_tcp_, headerImage_))
+          return false;
       }
       if(!readMarker())
         return false;
@@ -331,6 +344,18 @@ bool CodeStreamDecompress::parseTileParts(bool* canDecompress)
     grklog.error("Failed to merge PPT data");
     return false;
   }
+  // packet lengths from the code stream index stand in for missing PLT markers;
+  // when building the index, T2 records the lengths of the packets it parses
+  auto tileIndex = currentTileProcessor_->getIndex();
+  auto packetLengthCache = &currentTileProcessor_->packetLengthCache;
+  bool packedHeaders = cp_.ppm_marker || cp_.tcps[tileIndex].ppt;
+  bool usePLT =
+      !(cp_.coding_params_.dec_.disable_random_access_flags_ & GRK_RANDOM_ACCESS_PLT);
+  if(index_ && !buildingIndex_ && usePLT && !packedHeaders && !packetLengthCache->getMarkers() &&
+     !index_->installPacketLengths(tileIndex, packetLengthCache))
+    grklog.warn("Ignoring indexed packet lengths for tile %u", tileIndex);
+  currentTileProcessor_->recordPacketLengths_ =
+      buildingIndex_ && !packedHeaders && !packetLengthCache->getMarkers();
   if(!currentTileProcessor_->init())
   {
     grklog.error("Cannot decompress tile %u", currentTileProcessor_->getIndex());
@@ -488,8 +513,19 @@ bool CodeStreamDecompress::read_plm(uint8_t* headerData, uint16_t header_size)
  */
 bool CodeStreamDecompress::read_plt(uint8_t* headerData, uint16_t header_size)
 {
-  (void)headerData;
-  (void)header_size;
+  assert(headerData != nullptr);
+  if(cp_.coding_params_.dec_.disable_random_access_flags_ & GRK_RANDOM_ACCESS_PLT)
+    return true;
+  auto markers = currentProcessor()->packetLengthCache.createMarkers(nullptr);
+  if(!markers->isEnabled())
+    return true;
+  // packet lengths are an optimization, so a bad marker is not fatal
+  if(!markers->readPLT(headerData, header_size))
+  {
+    grklog.warn("Ignoring PLT markers for tile %u", currentProcessor()->getIndex());
+    markers->disable();
+  }
+
   return true;
 }
 /**
@@ -69,7 +69,8 @@ TileCodingParams::TileCodingParams()
       tilePartCounter_(0), numTileParts_(0), compressedTileData_(nullptr), mct_norms(nullptr),
       mct_decoding_matrix_(nullptr), mct_coding_matrix_(nullptr), mct_records_(nullptr),
       nb_mct_records_(0), nb_max_mct_records_(0), mcc_records_(nullptr), nb_mcc_records_(0),
-      nb_max_mcc_records_(0), cod(false), ppt(false), qcd_(nullptr), ht_(false)
+      nb_max_mcc_records_(0), cod(false), ppt(false), qcd_(nullptr), initialized_(false),
+      ht_(false)
 {
   for(auto i = 0; i < maxCompressLayersGRK; ++i)
     rates[i] = 0.0;
@@ -131,9 +132,12 @@ bool TileCodingParams::copy(const TileCodingParams* rhs, const GrkImage* image)
   uint32_t tccp_size = image->numcomps * (uint32_t)sizeof(TileComponentCodingParams);
   uint64_t mct_size = (uint64_t)image->numcomps * image->numcomps * sizeof(float);
 
-  // cache tccps
+  // cache tccps, and tile part state that may already have been read from SOT
   auto cachedTccps = tccps;
   auto cachedQcd = qcd_;
+  auto cachedTilePartCounter = tilePartCounter_;
+  auto cachedNumTileParts = numTileParts_;
+  auto cachedCompressedTileData = compressedTileData_;
   *this = *rhs;
   /* Initialize some values of the current tile coding parameters*/
   cod = false;
@@ -145,9 +149,12 @@ bool TileCodingParams::copy(const TileCodingParams* rhs, const GrkImage* image)
   mct_records_ = nullptr;
   nb_max_mcc_records_ = 0;
   mcc_records_ = nullptr;
-  // restore tccps
+  // restore tccps and tile part state
   tccps = cachedTccps;
   qcd_ = cachedQcd;
+  tilePartCounter_ = cachedTilePartCounter;
+  numTileParts_ = cachedNumTileParts;
+  compressedTileData_ = cachedCompressedTileData;
 
   /* Get the mct_decoding_matrix of the dflt_tile_cp and copy them into the current tile cp*/
   if(rhs->mct_decoding_matrix_)
@@ -212,6 +219,23 @@ bool TileCodingParams::copy(const TileCodingParams* rhs, const GrkImage* image)
   return true;
 }
 
+/**
+ * Tiles keep default constructed coding parameters until their first scheduled
+ * tile part is parsed, so tiles outside of the decompress region never pay for
+ * a deep copy of the main header defaults
+ */
+bool TileCodingParams::initFromDefault(const TileCodingParams* defaultTcp, const GrkImage* image)
+{
+  if(initialized_)
+    return true;
+  if(!tccps)
+    tccps = new TileComponentCodingParams[image->numcomps];
+  if(!copy(defaultTcp, image))
+    return false;
+  initialized_ = true;
+
+  return true;
+}
 void TileCodingParams::setIsHT(bool ht, bool reversible, uint8_t guardBits)
 {
   ht_ = ht;
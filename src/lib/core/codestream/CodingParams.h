@@ -125,6 +125,7 @@ struct TileCodingParams
 
   bool advanceTilePartCounter(uint16_t tile_index, uint8_t tilePartIndex);
   bool copy(const TileCodingParams* rhs, const GrkImage* image);
+  bool initFromDefault(const TileCodingParams* defaultTcp, const GrkImage* image);
   void setIsHT(bool ht, bool reversible, uint8_t guardBits);
   bool isHT(void);
   uint32_t getNumProgressions(void);
@@ -198,6 +199,8 @@ struct TileCodingParams
   /** If ppt == true --> there was a PPT marker for the present tile */
   bool ppt;
   Quantizer* qcd_;
+  /** true once tile has its own copy of the default coding parameters */
+  bool initialized_;
 
 private:
   bool ht_;
@@ -222,6 +225,8 @@ struct EncodingParams
   bool write_plt;
   /* write TLM marker */
   bool write_tlm;
+  /* maximum number of tiles compressed concurrently (0 for number of worker threads) */
+  uint32_t maxTilesInFlight_;
   /* rate control algorithm */
   uint32_t rate_control_algorithm;
 };
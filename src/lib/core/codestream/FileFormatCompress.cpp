@@ -916,6 +916,10 @@ uint64_t FileFormatCompress::compress(grk_plugin_tile* tile)
 
   return rc;
 }
+void FileFormatCompress::getMemoryStats(grk_memory_stats* stats)
+{
+  codeStream->getMemoryStats(stats);
+}
 bool FileFormatCompress::end(void)
 {
   /* write header */
@@ -31,6 +31,7 @@ public:
   bool init(grk_cparameters* p_param, GrkImage* p_image);
   bool start(void);
   uint64_t compress(grk_plugin_tile* tile);
+  void getMemoryStats(grk_memory_stats* stats);
 
 private:
   bool end(void);
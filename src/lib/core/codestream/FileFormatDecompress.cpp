@@ -93,9 +93,9 @@ void FileFormatDecompress::serializeAsoc(AsocBox* asoc, grk_asoc* serial_asocs,
   for(auto& child : asoc->children)
     serializeAsoc(child, serial_asocs, num_asocs, level + 1);
 }
-GrkImage* FileFormatDecompress::getImage(uint16_t tile_index)
+GrkImage* FileFormatDecompress::getImage(uint16_t tile_index, bool wait)
 {
-  return codeStream->getImage(tile_index);
+  return codeStream->getImage(tile_index, wait);
 }
 GrkImage* FileFormatDecompress::getImage(void)
 {
@@ -263,11 +263,15 @@ bool FileFormatDecompress::setDecompressRegion(grk_rect_double region)
 {
   return codeStream->setDecompressRegion(region);
 }
+void FileFormatDecompress::setDecompressBuffer(const grk_decompress_buffer* buffer)
+{
+  codeStream->setDecompressBuffer(buffer);
+}
 /** Set up decompressor function handler */
-void FileFormatDecompress::init(grk_decompress_core_params* parameters)
+void FileFormatDecompress::init(grk_decompress_parameters* parameters, grk_object* codec)
 {
   /* set up the J2K codec */
-  codeStream->init(parameters);
+  codeStream->init(parameters, codec);
 }
 bool FileFormatDecompress::decompress(grk_plugin_tile* tile)
 {
@@ -303,6 +307,10 @@ bool FileFormatDecompress::preProcess(void)
   }
   return true;
 }
+void FileFormatDecompress::wait(grk_wait_swath* swath)
+{
+  codeStream->wait(swath);
+}
 bool FileFormatDecompress::postProcess(void)
 {
   return codeStream->postProcess();
@@ -392,6 +400,14 @@ uint32_t FileFormatDecompress::read_asoc(AsocBox* parent, uint8_t** header_data,
 
   return asocBytesUsed;
 }
+void FileFormatDecompress::getTileCacheStats(grk_tile_cache_stats* stats)
+{
+  codeStream->getTileCacheStats(stats);
+}
+void FileFormatDecompress::getMemoryStats(grk_memory_stats* stats)
+{
+  codeStream->getMemoryStats(stats);
+}
 void FileFormatDecompress::dump(uint32_t flag, FILE* outputFileStream)
 {
   codeStream->dump(flag, outputFileStream);
@@ -31,12 +31,16 @@ public:
   FileFormatDecompress(BufferedStream* stream);
   virtual ~FileFormatDecompress();
   bool readHeader(grk_header_info* header_info);
-  GrkImage* getImage(uint16_t tile_index);
+  GrkImage* getImage(uint16_t tile_index, bool wait);
   GrkImage* getImage(void);
-  void init(grk_decompress_core_params* p_param);
+  void init(grk_decompress_parameters* param, grk_object* codec);
   bool setDecompressRegion(grk_rect_double region);
+  void setDecompressBuffer(const grk_decompress_buffer* buffer);
   bool decompress(grk_plugin_tile* tile);
+  void wait(grk_wait_swath* swath);
   bool decompressTile(uint16_t tile_index);
+  void getTileCacheStats(grk_tile_cache_stats* stats);
+  void getMemoryStats(grk_memory_stats* stats);
   bool end(void);
   bool postProcess(void);
   bool preProcess(void);
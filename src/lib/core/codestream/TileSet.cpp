@@ -3,7 +3,7 @@
 namespace grk
 {
 
-TileSet::TileSet() : lastTileToDecompress_(0) {}
+TileSet::TileSet() : lastTileToDecompress_(0), allDecoded_(true) {}
 uint16_t TileSet::numScheduled(void)
 {
   return (uint16_t)tilesToDecompress_.size();
@@ -74,4 +74,64 @@ bool TileSet::allComplete(void)
 {
   return tilesDecompressed_.size() == tilesToDecompress_.size();
 }
+void TileSet::resetDecoded(void)
+{
+  std::lock_guard<std::mutex> lock(decodedMutex_);
+  tilesDecoded_.clear();
+  allDecoded_ = false;
+}
+void TileSet::setDecoded(uint16_t tile_index)
+{
+  {
+    std::lock_guard<std::mutex> lock(decodedMutex_);
+    tilesDecoded_.insert(tile_index);
+  }
+  decodedCondition_.notify_all();
+}
+void TileSet::setAllDecoded(void)
+{
+  {
+    std::lock_guard<std::mutex> lock(decodedMutex_);
+    allDecoded_ = true;
+  }
+  decodedCondition_.notify_all();
+}
+bool TileSet::isDecoded(uint16_t tile_index)
+{
+  std::lock_guard<std::mutex> lock(decodedMutex_);
+  return allDecoded_ || tilesDecoded_.contains(tile_index);
+}
+void TileSet::waitForDecoded(grk_rect16 tiles)
+{
+  tiles = tiles.intersection(allTiles_);
+  std::unique_lock<std::mutex> lock(decodedMutex_);
+  decodedCondition_.wait(lock, [this, tiles] {
+    if(allDecoded_)
+      return true;
+    for(uint16_t j = tiles.y0; j < tiles.y1; ++j)
+    {
+      for(uint16_t i = tiles.x0; i < tiles.x1; ++i)
+      {
+        auto tile_index = index(i, j);
+        // tiles that were not scheduled will never be decoded
+        if(tilesToDecompress_.contains(tile_index) && !tilesDecoded_.contains(tile_index))
+          return false;
+      }
+    }
+    return true;
+  });
+}
+void TileSet::waitForDecoded(uint16_t tile_index)
+{
+  std::unique_lock<std::mutex> lock(decodedMutex_);
+  decodedCondition_.wait(lock, [this, tile_index] {
+    return allDecoded_ || !tilesToDecompress_.contains(tile_index) ||
+           tilesDecoded_.contains(tile_index);
+  });
+}
+void TileSet::waitForAllDecoded(void)
+{
+  std::unique_lock<std::mutex> lock(decodedMutex_);
+  decodedCondition_.wait(lock, [this] { return allDecoded_; });
+}
 } // namespace grk
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <set>
+#include <mutex>
+#include <condition_variable>
 
 namespace grk
 {
@@ -22,6 +24,23 @@ public:
   bool allComplete(void);
   uint16_t getSingle(void);
 
+  /**
+   * Decode completion. Unlike setComplete, which records that all tile parts
+   * of a tile have been parsed, these track tiles that have been fully decoded
+   * and composited. They may be called concurrently from worker threads.
+   */
+  void resetDecoded(void);
+  void setDecoded(uint16_t tile_index);
+  void setAllDecoded(void);
+  bool isDecoded(uint16_t tile_index);
+  /**
+   * Block until all scheduled tiles in tile rectangle have been decoded,
+   * or until decompression has finished
+   */
+  void waitForDecoded(grk_rect16 tiles);
+  void waitForDecoded(uint16_t tile_index);
+  void waitForAllDecoded(void);
+
 private:
   uint16_t index(uint16_t x, uint16_t y);
   uint16_t index(grk_pt16 tile);
@@ -29,6 +48,11 @@ private:
   std::set<uint16_t> tilesDecompressed_;
   grk_rect16 allTiles_;
   uint16_t lastTileToDecompress_;
+
+  std::set<uint16_t> tilesDecoded_;
+  bool allDecoded_;
+  std::mutex decodedMutex_;
+  std::condition_variable decodedCondition_;
 };
 
 } // namespace grk
@@ -256,8 +256,6 @@ bool SIZMarker::read(CodeStreamDecompress* codeStream, uint8_t* headerData, uint
   for(uint16_t i = 0; i < image->numcomps; ++i)
     if(!image->comps[i].sgnd)
       decompressState->default_tcp_->tccps[i].dc_level_shift_ = 1 << (image->comps[i].prec - 1);
-  for(uint16_t i = 0; i < numTiles; ++i)
-    (cp->tcps + i)->tccps = new TileComponentCodingParams[image->numcomps];
   decompressState->setState(DECOMPRESS_STATE_MH);
   subsampleAndReduceHeaderImageComponents(image, cp);
 
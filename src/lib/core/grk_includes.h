@@ -94,6 +94,9 @@
 #include "CodeStreamLimits.h"
 #include "geometry.h"
 #include "MemManager.h"
+#include "Arena.h"
+#include "BufferPool.h"
+#include "MemoryTracker.h"
 #include "buffer.h"
 #include "minpf_plugin_manager.h"
 #include "plugin_interface.h"
@@ -103,6 +106,7 @@
 #include "ChronoTimer.h"
 #include "testing.h"
 #include "MemStream.h"
+#include "HttpStream.h"
 #include "GrkMatrix.h"
 #include "GrkImage.h"
 #include "grk_exceptions.h"
@@ -113,6 +117,7 @@
 #include "LengthCache.h"
 #include "PLMarkerMgr.h"
 #include "PLCache.h"
+#include "CodeStreamIndex.h"
 #include "SIZMarker.h"
 #include "PPMMarker.h"
 #include "SOTMarker.h"
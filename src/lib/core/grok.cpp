@@ -27,6 +27,7 @@
 #include <sys/mman.h>
 #endif
 #include <fcntl.h>
+#include <filesystem>
 
 #include "grk_includes.h"
 using namespace grk;
@@ -78,16 +79,22 @@ static bool grk_compress_start(grk_object* codec);
  *
  * @param fname           the name of the file to stream
  * @param buffer_size     size of the chunk used to stream
+ * @param initial_buffer_size size of the first chunk read (0 for buffer_size)
  * @param is_read_stream  whether the stream is a read stream (true) or not (false)
  */
 static grk_stream* grk_stream_create_file_stream(const char* fname, size_t buffer_size,
-                                                 bool is_read_stream);
+                                                 size_t initial_buffer_size, bool is_read_stream);
 
 static grk_stream* grk_stream_create_stream(grk_stream_params* stream_params);
 
-static grk_stream* grk_stream_new(size_t buffer_size, bool is_input)
+static grk_stream* grk_stream_new(size_t buffer_size, size_t initial_buffer_size, bool is_input)
 {
-  auto streamImpl = new BufferedStream(nullptr, buffer_size, is_input);
+  if(!initial_buffer_size)
+    initial_buffer_size = buffer_size;
+  auto streamImpl =
+      new BufferedStream(nullptr, std::max(buffer_size, initial_buffer_size), is_input);
+  if(is_input)
+    streamImpl->setReadAhead(initial_buffer_size, buffer_size);
 
   return streamImpl->getWrapper();
 }
@@ -190,6 +197,8 @@ bool grk_initialize(const char* pluginPath, uint32_t numThreads)
     }
     grk_set_msg_handlers(handlers);
   }
+  const char* hugePagesEnv = std::getenv("GRK_HUGE_PAGES");
+  grk_set_huge_pages(hugePagesEnv && std::atoi(hugePagesEnv) == 1);
 
   initState_ = newState;
 
@@ -212,6 +221,7 @@ GRK_API void GRK_CALLCONV grk_deinitialize()
 {
   grk_plugin_cleanup();
   ExecSingleton::destroy();
+  BufferPool::get().clear();
 }
 
 GRK_API grk_object* GRK_CALLCONV grk_object_ref(grk_object* obj)
@@ -251,6 +261,32 @@ static size_t grk_read_from_file(uint8_t* buffer, size_t numBytes, void* p_file)
   return fread(buffer, 1, numBytes, (FILE*)p_file);
 }
 
+#ifndef _WIN32
+static size_t grk_read_from_file_at(uint64_t offset, uint8_t* buffer, size_t numBytes,
+                                    void* p_file)
+{
+  // pread neither uses nor moves the FILE position, so it is safe alongside fread
+  auto fd = fileno((FILE*)p_file);
+  size_t total = 0;
+  while(total < numBytes)
+  {
+    auto rc = pread(fd, buffer + total, numBytes - total, (off_t)(offset + total));
+    if(rc <= 0)
+      break;
+    total += (size_t)rc;
+  }
+  return total;
+}
+#endif
+
+#ifdef POSIX_FADV_WILLNEED
+static void grk_prefetch_from_file(uint64_t offset, uint64_t numBytes, void* p_file)
+{
+  // kernel read-ahead is asynchronous: the hint returns before the data arrives
+  posix_fadvise(fileno((FILE*)p_file), (off_t)offset, (off_t)numBytes, POSIX_FADV_WILLNEED);
+}
+#endif
+
 static uint64_t grk_get_data_length_from_file(void* filePtr)
 {
   auto file = (FILE*)filePtr;
@@ -345,6 +381,18 @@ bool GRK_CALLCONV grk_decompress_detect_format(const char* fileName, GRK_CODEC_F
   uint8_t buf[12];
   size_t bytesRead;
 
+  if(is_network_url(fileName))
+  {
+    grk_stream_params stream_params = {};
+    stream_params.file = fileName;
+    auto stream = create_http_read_stream(&stream_params);
+    if(!stream)
+      return false;
+    *fmt = BufferedStream::getImpl(stream)->getFormat();
+    grk_object_unref(stream);
+
+    return true;
+  }
   auto reader = fopen(fileName, "rb");
   if(!reader)
   {
@@ -405,14 +453,53 @@ static grk_object* grk_decompress_create_from_callbacks(grk_stream_params* strea
   return codec;
 }
 
-static grk_object* grk_decompress_create_from_file(const char* file_name)
+/**
+ * Gets identity of a file: absolute path, length and modification time
+ *
+ * @return identity, or empty string if file cannot be queried
+ */
+static std::string grk_get_file_identity(const char* fileName)
+{
+  std::error_code ec;
+  auto path = std::filesystem::absolute(fileName, ec);
+  if(ec)
+    return "";
+  auto length = std::filesystem::file_size(path, ec);
+  if(ec)
+    return "";
+  auto modified = std::filesystem::last_write_time(path, ec);
+  if(ec)
+    return "";
+
+  return path.string() + "|" + std::to_string(length) + "|" +
+         std::to_string(modified.time_since_epoch().count());
+}
+
+static grk_object* grk_decompress_create_from_file(grk_stream_params* stream_params)
 {
-  auto stream = grk_stream_create_file_stream(file_name, 1000000, true);
+  auto file_name = stream_params->file;
+  grk_stream* stream = nullptr;
+  bool network = stream_params->from_network || is_network_url(file_name);
+  if(network)
+    stream = create_http_read_stream(stream_params);
+  // fall back to stdio for stdin, pipes and files that cannot be mapped
+  else if(!stream_params->use_stdio)
+    stream = create_mapped_file_read_stream(file_name);
+  if(!stream && !network)
+  {
+    size_t doubleBufferLen =
+        stream_params->double_buffer_len ? stream_params->double_buffer_len : 1000000;
+    stream = grk_stream_create_file_stream(file_name, doubleBufferLen,
+                                           stream_params->initial_double_buffer_len, true);
+  }
   if(!stream)
   {
     grklog.error("Unable to create stream for file %s.", file_name);
     return nullptr;
   }
+  // stdin has no identity
+  if(!network && file_name && file_name[0])
+    BufferedStream::getImpl(stream)->setIdentity(grk_get_file_identity(file_name));
   auto codec = grk_decompress_create(stream);
   if(!codec)
   {
@@ -440,7 +527,7 @@ grk_object* GRK_CALLCONV grk_decompress_init(grk_stream_params* stream_params,
   }
   grk_object* codec = nullptr;
   if(stream_params->file)
-    codec = grk_decompress_create_from_file(stream_params->file);
+    codec = grk_decompress_create_from_file(stream_params);
   else if(stream_params->buf)
     codec = grk_decompress_create_from_buffer(stream_params->buf, stream_params->buf_len);
   else if(stream_params->read_fn)
@@ -457,7 +544,7 @@ grk_object* GRK_CALLCONV grk_decompress_init(grk_stream_params* stream_params,
 
     return nullptr;
   }
-  codecImpl->decompressor_->init(&params->core);
+  codecImpl->decompressor_->init(params, codec);
 
   return codec;
 }
@@ -487,22 +574,38 @@ bool GRK_CALLCONV grk_decompress_set_window(grk_object* codecWrapper, double sta
   }
   return false;
 }
+bool GRK_CALLCONV grk_decompress_set_buffer(grk_object* codecWrapper,
+                                            const grk_decompress_buffer* buffer)
+{
+  if(!codecWrapper || (buffer && !buffer->data))
+    return false;
+  auto codec = GrkCodec::getImpl(codecWrapper);
+  if(!codec->decompressor_)
+    return false;
+  codec->decompressor_->setDecompressBuffer(buffer);
+
+  return true;
+}
 bool GRK_CALLCONV grk_decompress(grk_object* codecWrapper, grk_plugin_tile* tile)
 {
   if(codecWrapper)
   {
     auto codec = GrkCodec::getImpl(codecWrapper);
-    bool rc = codec->decompressor_ ? codec->decompressor_->decompress(tile) : false;
-    rc = rc && (codec->decompressor_ ? codec->decompressor_->postProcess() : false);
 
-    return rc;
+    // post processing is performed by decompressor, as it may run asynchronously
+    return codec->decompressor_ ? codec->decompressor_->decompress(tile) : false;
   }
   return false;
 }
 
-void GRK_CALLCONV grk_decompress_wait(grk_object* codecWrapper)
+void GRK_CALLCONV grk_decompress_wait(grk_object* codecWrapper, grk_wait_swath* swath)
 {
-  (void)codecWrapper;
+  if(codecWrapper)
+  {
+    auto codec = GrkCodec::getImpl(codecWrapper);
+    if(codec->decompressor_)
+      codec->decompressor_->wait(swath);
+  }
 }
 bool GRK_CALLCONV grk_decompress_tile(grk_object* codecWrapper, uint16_t tile_index)
 {
@@ -515,6 +618,32 @@ bool GRK_CALLCONV grk_decompress_tile(grk_object* codecWrapper, uint16_t tile_in
   }
   return false;
 }
+bool GRK_CALLCONV grk_decompress_get_tile_cache_stats(grk_object* codecWrapper,
+                                                      grk_tile_cache_stats* stats)
+{
+  if(!codecWrapper || !stats)
+    return false;
+  auto codec = GrkCodec::getImpl(codecWrapper);
+  if(!codec->decompressor_)
+    return false;
+  codec->decompressor_->getTileCacheStats(stats);
+
+  return true;
+}
+bool GRK_CALLCONV grk_get_memory_stats(grk_object* codecWrapper, grk_memory_stats* stats)
+{
+  if(!codecWrapper || !stats)
+    return false;
+  auto codec = GrkCodec::getImpl(codecWrapper);
+  if(codec->decompressor_)
+    codec->decompressor_->getMemoryStats(stats);
+  else if(codec->compressor_)
+    codec->compressor_->getMemoryStats(stats);
+  else
+    return false;
+
+  return true;
+}
 void GRK_CALLCONV grk_dump_codec(grk_object* codecWrapper, uint32_t info_flag, FILE* output_stream)
 {
   assert(codecWrapper);
@@ -555,16 +684,21 @@ bool grk_set_MCT(grk_cparameters* parameters, const float* pEncodingMatrix, int3
   memcpy(((uint8_t*)parameters->mct_data) + l_matrix_size, p_dc_shift, l_dc_shift_size);
   return true;
 }
-grk_image* GRK_CALLCONV grk_decompress_get_tile_image(grk_object* codecWrapper, uint16_t tile_index)
+grk_image* GRK_CALLCONV grk_decompress_get_tile_image(grk_object* codecWrapper,
+                                                      uint16_t tile_index, bool wait)
 {
   if(!codecWrapper)
     return nullptr;
   auto codec = GrkCodec::getImpl(codecWrapper);
   if(!codec->decompressor_)
     return nullptr;
-  auto img = codec->decompressor_->getImage(tile_index);
+  auto img = codec->decompressor_->getImage(tile_index, wait);
   if(!img)
+  {
     img = codec->decompressor_->getImage();
+    if(img)
+      grk_object_ref(&img->obj);
+  }
   return img;
 }
 
@@ -661,7 +795,9 @@ grk_object* GRK_CALLCONV grk_compress_init(grk_stream_params* stream_params,
   }
   else if(stream_params->file)
   {
-    stream = grk_stream_create_file_stream(stream_params->file, 1024 * 1024, false);
+    size_t doubleBufferLen =
+        stream_params->double_buffer_len ? stream_params->double_buffer_len : 1024 * 1024;
+    stream = grk_stream_create_file_stream(stream_params->file, doubleBufferLen, 0, false);
   }
   else if(stream_params->write_fn)
   {
@@ -738,10 +874,15 @@ static void grkFree_file(void* p_user_data)
 static grk_stream* grk_stream_create_stream(grk_stream_params* stream_params)
 {
   bool readStream = stream_params->read_fn;
-  size_t doubleBufferLen = 16 * 1024 * 1024;
+  size_t doubleBufferLen =
+      stream_params->double_buffer_len ? stream_params->double_buffer_len : 16 * 1024 * 1024;
+  size_t initialDoubleBufferLen = stream_params->initial_double_buffer_len;
   if(stream_params->stream_len)
+  {
     doubleBufferLen = std::min(doubleBufferLen, stream_params->stream_len);
-  auto stream = grk_stream_new(doubleBufferLen, readStream);
+    initialDoubleBufferLen = std::min(initialDoubleBufferLen, stream_params->stream_len);
+  }
+  auto stream = grk_stream_new(doubleBufferLen, initialDoubleBufferLen, readStream);
   if(!stream)
     return nullptr;
   // validate
@@ -766,6 +907,7 @@ static grk_stream* grk_stream_create_stream(grk_stream_params* stream_params)
   if(readStream)
     grk_stream_set_user_data_length(stream, stream_params->stream_len);
   grk_stream_set_read_function(stream, stream_params->read_fn);
+  grk_stream_set_read_at_function(stream, stream_params->read_at_fn);
   grk_stream_set_write_function(stream, stream_params->write_fn);
   grk_stream_set_seek_function(stream, stream_params->seek_fn);
 
@@ -773,7 +915,7 @@ static grk_stream* grk_stream_create_stream(grk_stream_params* stream_params)
 }
 
 static grk_stream* grk_stream_create_file_stream(const char* fname, size_t buffer_size,
-                                                 bool is_read_stream)
+                                                 size_t initial_buffer_size, bool is_read_stream)
 {
   bool stdin_stdout = !fname || !fname[0];
   FILE* file = nullptr;
@@ -788,7 +930,7 @@ static grk_stream* grk_stream_create_file_stream(const char* fname, size_t buffe
     if(!file)
       return nullptr;
   }
-  auto stream = grk_stream_new(buffer_size, is_read_stream);
+  auto stream = grk_stream_new(buffer_size, initial_buffer_size, is_read_stream);
   if(!stream)
   {
     if(!stdin_stdout)
@@ -817,6 +959,15 @@ static grk_stream* grk_stream_create_file_stream(const char* fname, size_t buffe
   if(is_read_stream)
     grk_stream_set_user_data_length(stream, grk_get_data_length_from_file(file));
   grk_stream_set_read_function(stream, grk_read_from_file);
+#ifndef _WIN32
+  // positional reads require a regular file; stdin may be a pipe
+  if(is_read_stream && !stdin_stdout)
+    grk_stream_set_read_at_function(stream, grk_read_from_file_at);
+#endif
+#ifdef POSIX_FADV_WILLNEED
+  if(is_read_stream && !stdin_stdout)
+    grk_stream_set_prefetch_function(stream, grk_prefetch_from_file);
+#endif
   grk_stream_set_write_function(stream, grk_write_to_file);
   grk_stream_set_seek_function(stream, grk_seek_in_file);
   return stream;
@@ -1090,6 +1241,21 @@ void grk_stream_set_read_function(grk_stream* stream, grk_stream_read_fn func)
   streamImpl->setReadFunction(func);
 }
 
+void grk_stream_set_read_at_function(grk_stream* stream, grk_stream_read_at_fn func)
+{
+  auto streamImpl = BufferedStream::getImpl(stream);
+  if((!streamImpl) || (!(streamImpl->getStatus() & GROK_STREAM_STATUS_INPUT)))
+    return;
+  streamImpl->setReadAtFunction(func);
+}
+void grk_stream_set_prefetch_function(grk_stream* stream, grk_stream_prefetch_fn func)
+{
+  auto streamImpl = BufferedStream::getImpl(stream);
+  if((!streamImpl) || (!(streamImpl->getStatus() & GROK_STREAM_STATUS_INPUT)))
+    return;
+  streamImpl->setPrefetchFunction(func);
+}
+
 void grk_stream_set_seek_function(grk_stream* stream, grk_stream_seek_fn func)
 {
   auto streamImpl = BufferedStream::getImpl(stream);
@@ -89,6 +89,17 @@ typedef enum _GRK_COLOR_SPACE
   GRK_CLRSPC_ICC = 9 /** ICC profile */
 } GRK_COLOR_SPACE;
 
+/**
+ * @brief Sample data types of image component data
+ */
+typedef enum _GRK_DATA_TYPE
+{
+  GRK_INT_32 = 0, /** 32 bit signed integer */
+  GRK_UINT_8 = 1, /** 8 bit unsigned integer */
+  GRK_UINT_16 = 2, /** 16 bit unsigned integer */
+  GRK_FLOAT = 3 /** 32 bit float */
+} GRK_DATA_TYPE;
+
 /**
  * @brief JPEG 2000 enumerated color spaces
  */
@@ -524,6 +535,18 @@ typedef size_t (*grk_stream_write_fn)(const uint8_t* buffer, size_t numBytes, vo
  */
 typedef bool (*grk_stream_seek_fn)(uint64_t offset, void* user_data);
 
+/**
+ * @brief Positional read callback: reads from an absolute offset without
+ * changing the stream position. May be called concurrently from multiple threads.
+ * @param offset absolute stream offset
+ * @param buffer buffer to write stream to
+ * @param numBytes number of bytes to write to buffer
+ * @param user_data user data
+ *
+ */
+typedef size_t (*grk_stream_read_at_fn)(uint64_t offset, uint8_t* buffer, size_t numBytes,
+                                        void* user_data);
+
 /**
  * @brief Free user data callback
  * @param user_data user data
@@ -541,15 +564,21 @@ typedef struct _grk_stream_params
   /* 0. General Streaming */
   size_t initial_offset; /* initial offset into stream */
   size_t double_buffer_len; /* length of internal double buffer
-                               for stdio and callback streaming */
+                               for stdio and callback streaming (0 for default).
+                               When reading, this is the maximum read-ahead: read-ahead
+                               grows on sequential access and shrinks on seeks */
   size_t initial_double_buffer_len; /* choose a larger initial length
-                                       to read the main header in one go */
-  bool from_network; /* indicates stream source is on network if true */
+                                       to read the main header in one go
+                                       (0 for double_buffer_len) */
+  bool from_network; /* indicates stream source is on network if true : file is then
+                        fetched from a URL with HTTP range requests. http:// and https://
+                        file names are detected automatically */
   bool is_read_stream;
 
   /* 1. File Streaming */
   const char* file;
-  bool use_stdio; /* use C file api - if false then use memory mapping */
+  bool use_stdio; /* use C file api - if false then use memory mapping when decompressing,
+                     falling back to C file api if file cannot be mapped */
 
   /* 2. Buffer Streaming */
   uint8_t* buf;
@@ -564,12 +593,15 @@ typedef struct _grk_stream_params
   void* user_data; /* user data */
   size_t stream_len; /* mandatory for read stream */
 
-  /* 4 Authorization */
+  /* 4 Authorization (network streams) */
   const char* username;
   const char* password;
   const char* bearer_token;
-  const char* custom_header;
-  const char* region;
+  const char* custom_header; /* extra request headers, one per line */
+  const char* region; /* with username and password, sign requests for S3 compatible storage */
+
+  /* 5. Callback Streaming (continued) */
+  grk_stream_read_at_fn read_at_fn; /* optional thread-safe positional read function */
 
 } grk_stream_params;
 
@@ -624,8 +656,111 @@ typedef struct _grk_decompress_core_params
   grk_io_pixels_callback io_buffer_callback; /* IO buffer callback */
   void* io_user_data; /* IO user data */
   grk_io_register_reclaim_callback io_register_client_callback; /* IO register client callback */
+  /**
+   * Maximum number of bytes held by cached tiles: tile images kept by the tile cache strategy,
+   * and the tile state kept by @ref grk_decompress_tile. Once exceeded, the least recently used
+   * tiles are evicted, and will be decompressed again if requested.
+   * If value is zero or not set, or if the code stream has PPM markers, the cache is unbounded
+   */
+  uint64_t tile_cache_max_bytes;
+  /**
+   * Sample data type of the decompressed image (GRK_INT_32 if not set).
+   * Signed samples are offset by 2^(prec-1) into the unsigned range of narrow integer types,
+   * and samples are then clamped to the range of the type. For images that need no colour
+   * post processing, the inverse DC shift and MCT of a single tile image store samples of
+   * this type, and tiles of multi-tile images are stored directly into a composite of this
+   * type. Otherwise, samples are converted after post processing.
+   * Interleaved output is not affected
+   */
+  GRK_DATA_TYPE output_data_type;
+  /**
+   * Memory budget in bytes for concurrent tile decompression. Tiles are only admitted to the
+   * scheduler while the composite image and tile cache memory held by the codec, plus the
+   * measured footprint of each tile in flight, fits in the budget : at least one tile is always
+   * admitted, so a single tile larger than the budget is still decompressed.
+   * Memory is not otherwise capped.
+   * If value is zero or not set, all tiles are admitted
+   */
+  uint64_t memory_budget;
+  /**
+   * Path of sidecar code stream index, holding the main header, tile part locations and the
+   * packet lengths of tiles without PLT markers. If the index matches the code stream file or
+   * URL (path, length and modification time or entity tag), tile parts outside the decompress
+   * region are never scanned, and packets outside the region are skipped without parsing their
+   * headers. Otherwise, the index is built while the whole code stream is decompressed, and
+   * written to this path. Each indexed tile part is checked before it is used : if it does not
+   * match the code stream, the index is ignored.
+   * If value is null or not set, or the code stream is read from memory, no index is used
+   */
+  const char* index_file;
+  /**
+   * Keep code stream indices in a process-wide cache, keyed by file or URL identity and main
+   * header, so that a code stream that is reopened is not scanned again
+   */
+  bool cache_index;
 } grk_decompress_core_params;
 
+/**
+ * @struct grk_tile_cache_stats
+ * @brief Tile cache statistics (see @ref grk_decompress_get_tile_cache_stats)
+ */
+typedef struct _grk_tile_cache_stats
+{
+  uint64_t hits; /* tile requests served from the cache */
+  uint64_t misses; /* tile requests that required decompression */
+  uint64_t evictions; /* tiles evicted to stay within tile_cache_max_bytes */
+  uint64_t bytes; /* bytes currently held by cached tile images */
+  uint32_t num_tiles; /* number of cached tile images */
+} grk_tile_cache_stats;
+
+/**
+ * @brief Memory accounting categories (see @ref grk_get_memory_stats)
+ */
+typedef enum _GRK_MEM_CATEGORY
+{
+  GRK_MEM_COMPRESSED = 0, /* compressed tile data read from the stream */
+  GRK_MEM_TILE_WINDOW = 1, /* tile component window buffers */
+  GRK_MEM_COMPOSITE = 2, /* composite (output) image data */
+  GRK_MEM_T1 = 3, /* code block coder scratch (estimated) */
+  GRK_MEM_CACHE = 4, /* tile images and tile state held by the tile cache */
+  GRK_MEM_NUM_CATEGORIES = 5
+} GRK_MEM_CATEGORY;
+
+/**
+ * @struct grk_memory_stats
+ * @brief Memory accounting for a codec (see @ref grk_get_memory_stats)
+ */
+typedef struct _grk_memory_stats
+{
+  uint64_t current[GRK_MEM_NUM_CATEGORIES]; /* bytes currently held, by category */
+  uint64_t peak[GRK_MEM_NUM_CATEGORIES]; /* peak bytes held, by category */
+  uint64_t total_current; /* bytes currently held by all categories */
+  uint64_t total_peak; /* peak of total bytes held */
+  uint64_t budget; /* memory budget, or zero if there is none */
+  uint64_t tile_footprint; /* largest measured footprint of a single tile in flight */
+  uint64_t admission_waits; /* tiles that waited to be admitted, to stay within budget */
+} grk_memory_stats;
+
+/**
+ * @struct grk_decompress_buffer
+ * @brief Caller owned destination buffer for decompressed samples
+ * (see @ref grk_decompress_set_buffer)
+ *
+ * Sample (x,y) of component c, relative to the top left hand corner of the decompress region,
+ * is stored at
+ * planar:      data + c * plane_stride + y * stride + x * sample size
+ * interleaved: data + y * stride + (x * numcomps + c) * sample size
+ */
+typedef struct _grk_decompress_buffer
+{
+  uint8_t* data; /* buffer, which must remain valid until decompression completes */
+  uint64_t len; /* buffer length in bytes */
+  GRK_DATA_TYPE data_type; /* sample data type */
+  bool interleaved; /* true if components are interleaved, otherwise planar */
+  uint64_t stride; /* row stride in bytes */
+  uint64_t plane_stride; /* planar only : bytes between consecutive component planes */
+} grk_decompress_buffer;
+
 /**
  * @brief default compression level for decompression output file formats
  * that support compression
@@ -639,8 +774,10 @@ typedef struct _grk_decompress_core_params
 typedef struct _grk_decompress_params
 {
   grk_decompress_core_params core; /* core parameters */
-  bool asynchronous; /* if true then decompression is executed asynchronously */
-  bool simulate_synchronous;
+  bool asynchronous; /* if true then grk_decompress returns immediately, and client
+                       waits on decompression with grk_decompress_wait */
+  bool simulate_synchronous; /* run asynchronous decompression, but wait for it to complete
+                                before returning from grk_decompress */
   grk_decompress_callback decompress_callback; /* callback for asynchronous decompression */
   void* decompress_callback_user_data; /* user data passed to callback for asynchronous
                                           decompression */
@@ -690,7 +827,8 @@ typedef struct _grk_image_comp
   GRK_CHANNEL_ASSOC association; /* channel association */
   uint16_t crg_x; /* CRG x */
   uint16_t crg_y; /* CRG x */
-  int32_t* data; /* component data */
+  int32_t* data; /* component data: cast to the type signalled by data_type */
+  GRK_DATA_TYPE data_type; /* sample data type */
 } grk_image_comp;
 
 /**
@@ -760,6 +898,7 @@ typedef struct _grk_image
   uint64_t packed_row_bytes; /* packed row bytes */
   grk_image_meta* meta; /* image meta data */
   grk_image_comp* comps; /* components array */
+  GRK_DATA_TYPE decompress_data_type; /* decompress sample data type */
 } grk_image;
 
 /**
@@ -826,7 +965,8 @@ typedef struct _grk_header_info
  * @struct grk_wait_swath
  * @brief Specify swath to wait on
  * Holds swath coordinates and tile indices covering swath
- * Tile indices are set by library
+ * Swath coordinates are absolute canvas coordinates at the decompressed
+ * (possibly reduced) resolution. Tile indices are set by library
  */
 typedef struct grk_wait_swath
 {
@@ -942,7 +1082,10 @@ GRK_API const char* GRK_CALLCONV grk_version(void);
 
 /**
  * @brief Initializes Grok library
- * Must be called before any Grok API calls
+ * Must be called before any Grok API calls.
+ * If environment variable GRK_HUGE_PAGES is set to 1, then on Linux, large buffers
+ * are aligned to 2 MB and backed by transparent huge pages. Their pages are first touched
+ * by the worker threads that fill them, which keeps them local on NUMA hosts.
  * @param pluginPath 	path to plugin
  * @param num_threads number of threads to use for compress/decompress
  */
@@ -1052,7 +1195,10 @@ GRK_API bool GRK_CALLCONV grk_decompress_read_header(grk_object* codec,
  * @brief Gets decompressed tile image
  * @param	codec				decompression codec (see @ref grk_object)
  * @param	tile_index			tile index
- * @return pointer to @ref grk_image
+ * @param	wait				if true, wait for asynchronous decompression of tile to complete
+ * @return new reference to @ref grk_image, which the caller releases with @ref grk_object_unref.
+ * A tile evicted from the tile cache is decompressed again, once any asynchronous
+ * decompression has completed
  */
 GRK_API grk_image* GRK_CALLCONV grk_decompress_get_tile_image(grk_object* codec,
                                                               uint16_t tile_index, bool wait);
@@ -1079,6 +1225,24 @@ GRK_API grk_image* GRK_CALLCONV grk_decompress_get_image(grk_object* codec);
 GRK_API bool GRK_CALLCONV grk_decompress_set_window(grk_object* codec, double start_x,
                                                     double start_y, double end_x, double end_y);
 
+/**
+ * @brief Sets caller owned destination buffer for decompressed samples
+ * This function should be called after grk_decompress_read_header, and before
+ * grk_decompress or grk_decompress_tile. Tiles are then written directly into the buffer,
+ * and the composite image components hold no data.
+ * Decompression fails if the buffer is too small for the decompress region, if its stride is
+ * smaller than a row of samples (of all components, if interleaved), if planes overlap,
+ * or if the image requires colour post processing (palette, channel definition, ICC profile,
+ * colour conversion, precision or upsampling). Interleaved buffers are not supported
+ * for subsampled images.
+ * @param	codec			decompression codec (see @ref grk_object)
+ * @param	buffer			@ref grk_decompress_buffer, or nullptr to revert to
+ * library allocated composite image
+ * @return	true if buffer was set
+ */
+GRK_API bool GRK_CALLCONV grk_decompress_set_buffer(grk_object* codec,
+                                                    const grk_decompress_buffer* buffer);
+
 /**
  * @brief Decompresses image from a JPEG 2000 code stream
  * @param codec 	decompression codec (see @ref grk_object)
@@ -1089,6 +1253,10 @@ GRK_API bool GRK_CALLCONV grk_decompress(grk_object* codec, grk_plugin_tile* til
 
 /**
  * @brief Waits for an asynchronous decompression to complete
+ * Once all tiles covering a swath have been decompressed, the swath pixels
+ * are available in the composite image, although colour post processing
+ * (colour conversion, upsampling, precision) is only applied once the
+ * entire decompression has completed.
  * @param codec codec @ref grk_object
  * @param swath @ref grk_wait_swath to wait for. If null, then wait for
  * entire decompression to complete
@@ -1103,6 +1271,27 @@ GRK_API void GRK_CALLCONV grk_decompress_wait(grk_object* codec, grk_wait_swath*
  */
 GRK_API bool GRK_CALLCONV grk_decompress_tile(grk_object* codec, uint16_t tile_index);
 
+/**
+ * @brief Gets tile cache statistics
+ * Tile images may be evicted from a cache bounded by tile_cache_max_bytes: an image returned
+ * by @ref grk_decompress_get_tile_image remains valid until the client releases its reference
+ * @param	codec			decompression codec (see @ref grk_object)
+ * @param	stats			@ref grk_tile_cache_stats to fill
+ * @return					true if successful, otherwise false
+ */
+GRK_API bool GRK_CALLCONV grk_decompress_get_tile_cache_stats(grk_object* codec,
+                                                              grk_tile_cache_stats* stats);
+
+/**
+ * @brief Gets memory accounting for a codec
+ * Bytes are tracked per codec, and per category (see @ref GRK_MEM_CATEGORY). Peaks are held
+ * for the lifetime of the codec
+ * @param	codec			compression or decompression codec (see @ref grk_object)
+ * @param	stats			@ref grk_memory_stats to fill
+ * @return					true if successful, otherwise false
+ */
+GRK_API bool GRK_CALLCONV grk_get_memory_stats(grk_object* codec, grk_memory_stats* stats);
+
 /* COMPRESSION FUNCTIONS*/
 
 /**
@@ -1211,6 +1400,9 @@ typedef struct _grk_cparameters
   bool verbose; /* verbose */
   bool shared_memory_interface; /* shared memory interface */
   grk_synthesis synth; /* synthesis */
+  uint32_t max_tiles_in_flight; /* maximum number of tiles compressed concurrently. Tiles are
+                                   written in order as soon as they are complete, so peak memory
+                                   scales with this window. 0 means number of worker threads */
 } grk_cparameters;
 
 /**
@@ -1278,6 +1470,7 @@ GRK_API bool GRK_CALLCONV grk_set_MCT(grk_cparameters* parameters, const float*
 #define GRK_TCH_INFO 8 /** Tile/Component information of all tiles */
 #define GRK_MH_IND 16 /** Codestream index based only on the main header */
 #define GRK_TH_IND 32 /** Tile index based on the current tile */
+#define GRK_MEM_INFO 64 /** Memory accounting of the codec */
 
 /* Code block styles */
 #define GRK_CBLKSTY_LAZY 0x01 /** Selective arithmetic coding bypass */
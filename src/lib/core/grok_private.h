@@ -30,6 +30,29 @@ typedef grk_object grk_stream;
  */
 void grk_stream_set_read_function(grk_stream* stream, grk_stream_read_fn func);
 
+/**
+ * Set positional read function (optional - enables concurrent tile part reads)
+ *
+ * @param       stream      JPEG 2000 stream
+ * @param       func        thread-safe positional read function
+ */
+void grk_stream_set_read_at_function(grk_stream* stream, grk_stream_read_at_fn func);
+
+/**
+ * Callback function prototype for prefetch function: hints that a byte range
+ * will soon be read, so that the media can start fetching it in the background.
+ * Must not block on the read itself.
+ */
+typedef void (*grk_stream_prefetch_fn)(uint64_t offset, uint64_t numBytes, void* user_data);
+
+/**
+ * Set prefetch function (optional - overlaps media reads with decompression)
+ *
+ * @param       stream      JPEG 2000 stream
+ * @param       func        prefetch function
+ */
+void grk_stream_set_prefetch_function(grk_stream* stream, grk_stream_prefetch_fn func);
+
 /**
  * Set write function
  *
@@ -30,6 +30,49 @@ namespace grk
 namespace HWY_NAMESPACE
 {
   using namespace hwy::HWY_NAMESPACE;
+
+  /**
+   * Write row of clamped 32 bit samples to destination component of another sample type.
+   * Destination stride is a multiple of the vector length, so only whole vectors are written
+   */
+  static void writeRow(const SampleDest& dest, const int32_t* src, uint32_t y)
+  {
+    if(y >= dest.height_)
+      return;
+    const HWY_FULL(int32_t) di;
+    auto voffset = Set(di, dest.offset_);
+    auto destIndex = (uint64_t)y * dest.stride_;
+    switch(dest.dataType_)
+    {
+      case GRK_UINT_8:
+      {
+        const Rebind<uint8_t, decltype(di)> d8;
+        auto destRow = (uint8_t*)dest.data_ + destIndex;
+        for(uint32_t x = 0; x < dest.width_; x += (uint32_t)Lanes(di))
+          StoreU(DemoteTo(d8, Load(di, src + x) + voffset), d8, destRow + x);
+      }
+      break;
+      case GRK_UINT_16:
+      {
+        const Rebind<uint16_t, decltype(di)> d16;
+        auto destRow = (uint16_t*)dest.data_ + destIndex;
+        for(uint32_t x = 0; x < dest.width_; x += (uint32_t)Lanes(di))
+          StoreU(DemoteTo(d16, Load(di, src + x) + voffset), d16, destRow + x);
+      }
+      break;
+      case GRK_FLOAT:
+      {
+        const Rebind<float, decltype(di)> df;
+        auto destRow = (float*)dest.data_ + destIndex;
+        for(uint32_t x = 0; x < dest.width_; x += (uint32_t)Lanes(di))
+          StoreU(ConvertTo(df, Load(di, src + x)), df, destRow + x);
+      }
+      break;
+      default:
+        break;
+    }
+  }
+
   /**
    * Apply dc shift for irreversible decompressed image.
    * (assumes mono with no  MCT)
@@ -43,19 +86,23 @@ namespace HWY_NAMESPACE
       auto highestResBuffer =
           info.tile->comps[info.compno].getWindow()->getResWindowBufferHighestSimpleF();
       const std::vector<ShiftInfo>& shiftInfo = info.shiftInfo;
-      auto index = (uint64_t)info.yBegin * highestResBuffer.stride_;
-      auto chunkSize = (uint64_t)(info.yEnd - info.yBegin) * highestResBuffer.stride_;
+      auto stride = (uint64_t)highestResBuffer.stride_;
       auto chan0 = (float*)highestResBuffer.buf_;
       const HWY_FULL(int32_t) di;
       const HWY_FULL(float) df;
       auto vshift = Set(di, shiftInfo[0]._shift);
       auto vmin = Set(di, shiftInfo[0]._min);
       auto vmax = Set(di, shiftInfo[0]._max);
-      size_t begin = index;
-      for(auto j = begin; j < begin + chunkSize; j += Lanes(di))
+      for(uint32_t y = info.yBegin; y < info.yEnd; ++y)
       {
-        auto ni = Clamp(NearestInt(Load(df, chan0 + j)) + vshift, vmin, vmax);
-        Store(ni, di, (int32_t*)(chan0 + j));
+        auto begin = y * stride;
+        for(auto j = begin; j < begin + stride; j += Lanes(di))
+        {
+          auto ni = Clamp(NearestInt(Load(df, chan0 + j)) + vshift, vmin, vmax);
+          Store(ni, di, (int32_t*)(chan0 + j));
+        }
+        if(!info.dest.empty())
+          writeRow(info.dest[0], (int32_t*)(chan0 + begin), y);
       }
     }
   };
@@ -70,10 +117,8 @@ namespace HWY_NAMESPACE
   public:
     void transform(ScheduleInfo info)
     {
-      auto highestResBufferStride =
-          info.tile->comps[info.compno].getWindow()->getResWindowBufferHighestStride();
-      auto index = (uint64_t)info.yBegin * highestResBufferStride;
-      auto chunkSize = (uint64_t)(info.yEnd - info.yBegin) * highestResBufferStride;
+      auto stride =
+          (uint64_t)info.tile->comps[info.compno].getWindow()->getResWindowBufferHighestStride();
       const std::vector<ShiftInfo>& shiftInfo = info.shiftInfo;
       auto chan0 =
           info.tile->comps[info.compno].getWindow()->getResWindowBufferHighestSimple().buf_;
@@ -81,11 +126,16 @@ namespace HWY_NAMESPACE
       auto vshift = Set(di, shiftInfo[0]._shift);
       auto vmin = Set(di, shiftInfo[0]._min);
       auto vmax = Set(di, shiftInfo[0]._max);
-      size_t begin = index;
-      for(auto j = begin; j < begin + chunkSize; j += Lanes(di))
+      for(uint32_t y = info.yBegin; y < info.yEnd; ++y)
       {
-        auto ni = Clamp(Load(di, chan0 + j) + vshift, vmin, vmax);
-        Store(ni, di, chan0 + j);
+        auto begin = y * stride;
+        for(auto j = begin; j < begin + stride; j += Lanes(di))
+        {
+          auto ni = Clamp(Load(di, chan0 + j) + vshift, vmin, vmax);
+          Store(ni, di, chan0 + j);
+        }
+        if(!info.dest.empty())
+          writeRow(info.dest[0], chan0 + begin, y);
       }
     }
   };
@@ -98,10 +148,8 @@ namespace HWY_NAMESPACE
   public:
     void transform(ScheduleInfo info)
     {
-      auto highestResBufferStride =
-          info.tile->comps[info.compno].getWindow()->getResWindowBufferHighestStride();
-      auto index = (uint64_t)info.yBegin * highestResBufferStride;
-      auto chunkSize = (uint64_t)(info.yEnd - info.yBegin) * highestResBufferStride;
+      auto stride =
+          (uint64_t)info.tile->comps[info.compno].getWindow()->getResWindowBufferHighestStride();
       const std::vector<ShiftInfo>& shiftInfo = info.shiftInfo;
       auto chan0 = info.tile->comps[0].getWindow()->getResWindowBufferHighestSimple().buf_;
       auto chan1 = info.tile->comps[1].getWindow()->getResWindowBufferHighestSimple().buf_;
@@ -121,18 +169,27 @@ namespace HWY_NAMESPACE
       auto maxg = Set(di, _max[1]);
       auto maxb = Set(di, _max[2]);
 
-      size_t begin = index;
-      for(auto j = begin; j < begin + chunkSize; j += Lanes(di))
+      for(uint32_t row = info.yBegin; row < info.yEnd; ++row)
       {
-        auto y = Load(di, chan0 + j);
-        auto u = Load(di, chan1 + j);
-        auto v = Load(di, chan2 + j);
-        auto g = y - ShiftRight<2>(u + v);
-        auto r = v + g;
-        auto b = u + g;
-        Store(Clamp(r + vdcr, minr, maxr), di, chan0 + j);
-        Store(Clamp(g + vdcg, ming, maxg), di, chan1 + j);
-        Store(Clamp(b + vdcb, minb, maxb), di, chan2 + j);
+        auto begin = row * stride;
+        for(auto j = begin; j < begin + stride; j += Lanes(di))
+        {
+          auto y = Load(di, chan0 + j);
+          auto u = Load(di, chan1 + j);
+          auto v = Load(di, chan2 + j);
+          auto g = y - ShiftRight<2>(u + v);
+          auto r = v + g;
+          auto b = u + g;
+          Store(Clamp(r + vdcr, minr, maxr), di, chan0 + j);
+          Store(Clamp(g + vdcg, ming, maxg), di, chan1 + j);
+          Store(Clamp(b + vdcb, minb, maxb), di, chan2 + j);
+        }
+        if(!info.dest.empty())
+        {
+          writeRow(info.dest[0], chan0 + begin, row);
+          writeRow(info.dest[1], chan1 + begin, row);
+          writeRow(info.dest[2], chan2 + begin, row);
+        }
       }
     }
   };
@@ -145,10 +202,8 @@ namespace HWY_NAMESPACE
   public:
     void transform(ScheduleInfo info)
     {
-      auto highestResBufferStride =
-          info.tile->comps[info.compno].getWindow()->getResWindowBufferHighestStride();
-      auto index = (uint64_t)info.yBegin * highestResBufferStride;
-      auto chunkSize = (uint64_t)(info.yEnd - info.yBegin) * highestResBufferStride;
+      auto stride =
+          (uint64_t)info.tile->comps[info.compno].getWindow()->getResWindowBufferHighestStride();
       const std::vector<ShiftInfo>& shiftInfo = info.shiftInfo;
       auto chan0 = info.tile->comps[0].getWindow()->getResWindowBufferHighestSimpleF().buf_;
       auto chan1 = info.tile->comps[1].getWindow()->getResWindowBufferHighestSimpleF().buf_;
@@ -179,19 +234,28 @@ namespace HWY_NAMESPACE
       auto vgv = Set(df, 0.71414f);
       auto vbu = Set(df, 1.772f);
 
-      size_t begin = index;
-      for(auto j = begin; j < begin + chunkSize; j += Lanes(di))
+      for(uint32_t row = info.yBegin; row < info.yEnd; ++row)
       {
-        auto vy = Load(df, chan0 + j);
-        auto vu = Load(df, chan1 + j);
-        auto vv = Load(df, chan2 + j);
-        auto vr = vy + vv * vrv;
-        auto vg = vy - vu * vgu - vv * vgv;
-        auto vb = vy + vu * vbu;
-
-        Store(Clamp(NearestInt(vr) + vdcr, minr, maxr), di, c0 + j);
-        Store(Clamp(NearestInt(vg) + vdcg, ming, maxg), di, c1 + j);
-        Store(Clamp(NearestInt(vb) + vdcb, minb, maxb), di, c2 + j);
+        auto begin = row * stride;
+        for(auto j = begin; j < begin + stride; j += Lanes(di))
+        {
+          auto vy = Load(df, chan0 + j);
+          auto vu = Load(df, chan1 + j);
+          auto vv = Load(df, chan2 + j);
+          auto vr = vy + vv * vrv;
+          auto vg = vy - vu * vgu - vv * vgv;
+          auto vb = vy + vu * vbu;
+
+          Store(Clamp(NearestInt(vr) + vdcr, minr, maxr), di, c0 + j);
+          Store(Clamp(NearestInt(vg) + vdcg, ming, maxg), di, c1 + j);
+          Store(Clamp(NearestInt(vb) + vdcb, minb, maxb), di, c2 + j);
+        }
+        if(!info.dest.empty())
+        {
+          writeRow(info.dest[0], c0 + begin, row);
+          writeRow(info.dest[1], c1 + begin, row);
+          writeRow(info.dest[2], c2 + begin, row);
+        }
       }
     }
   };
@@ -324,7 +388,7 @@ namespace HWY_NAMESPACE
       }
       if(tasks)
       {
-        ExecSingleton::get().run(taskflow).wait();
+        ExecSingleton::run(taskflow);
         delete[] tasks;
       }
     }
@@ -386,8 +450,13 @@ HWY_EXPORT(hwy_decompress_irrev);
 HWY_EXPORT(hwy_decompress_dc_shift_irrev);
 HWY_EXPORT(hwy_decompress_dc_shift_rev);
 
-mct::mct(Tile* tile, GrkImage* image, TileCodingParams* tcp) : tile_(tile), image_(image), tcp_(tcp)
+mct::mct(Tile* tile, GrkImage* image, TileCodingParams* tcp)
+    : tile_(tile), image_(image), tcp_(tcp), dest_(nullptr)
 {}
+void mct::setDestination(GrkImage* dest)
+{
+  dest_ = dest;
+}
 /***
  * decompress dc shift only - irreversible
  */
@@ -396,6 +465,7 @@ void mct::decompress_dc_shift_irrev(FlowComponent* flow, uint16_t compno)
   ScheduleInfo info(tile_, flow, image_->rows_per_task);
   info.compno = compno;
   genShift(compno, 1, info.shiftInfo);
+  genDest(compno, info.dest);
   HWY_DYNAMIC_DISPATCH(hwy_decompress_dc_shift_irrev)(info);
 }
 /***
@@ -406,6 +476,7 @@ void mct::decompress_dc_shift_rev(FlowComponent* flow, uint16_t compno)
   ScheduleInfo info(tile_, flow, image_->rows_per_task);
   info.compno = compno;
   genShift(compno, 1, info.shiftInfo);
+  genDest(compno, info.dest);
   HWY_DYNAMIC_DISPATCH(hwy_decompress_dc_shift_rev)(info);
 }
 
@@ -418,6 +489,8 @@ void mct::decompress_irrev(FlowComponent* flow)
   ScheduleInfo info(tile_, flow, image_->rows_per_task);
   hwy::DisableTargets(uint32_t(~HWY_SCALAR));
   genShift(1, info.shiftInfo);
+  for(uint16_t i = 0; i < 3; ++i)
+    genDest(i, info.dest);
   HWY_DYNAMIC_DISPATCH(hwy_decompress_irrev)
   (info);
 }
@@ -429,6 +502,8 @@ void mct::decompress_rev(FlowComponent* flow)
 {
   ScheduleInfo info(tile_, flow, image_->rows_per_task);
   genShift(1, info.shiftInfo);
+  for(uint16_t i = 0; i < 3; ++i)
+    genDest(i, info.dest);
   HWY_DYNAMIC_DISPATCH(hwy_decompress_rev)
   (info);
 }
@@ -476,6 +551,14 @@ void mct::genShift(int32_t sign, std::vector<ShiftInfo>& shiftInfo)
   for(uint16_t i = 0; i < 3; ++i)
     genShift(i, sign, shiftInfo);
 }
+void mct::genDest(uint16_t compno, std::vector<SampleDest>& dest)
+{
+  if(!dest_)
+    return;
+  auto comp = dest_->comps + compno;
+  dest.push_back({comp->data, comp->data_type, comp->stride, comp->w, comp->h,
+                  GrkImage::unsignedOffset(comp, comp->data_type)});
+}
 
 void mct::calculate_norms(double* pNorms, uint16_t pNbComps, float* pMatrix)
 {
@@ -33,6 +33,28 @@ struct ShiftInfo
   int32_t _shift;
 };
 
+/**
+ * Image component that a decompress transform writes its clamped samples to,
+ * in a sample type other than 32 bit integer
+ */
+struct SampleDest
+{
+  SampleDest(void* data, GRK_DATA_TYPE dataType, uint32_t stride, uint32_t width,
+             uint32_t height, int32_t offset)
+      : data_(data), dataType_(dataType), stride_(stride), width_(width), height_(height),
+        offset_(offset)
+  {}
+  void* data_;
+  GRK_DATA_TYPE dataType_;
+  // stride in samples : a multiple of the vector length
+  uint32_t stride_;
+  uint32_t width_;
+  // tile buffer may have more rows than the component
+  uint32_t height_;
+  // added to samples converted to an unsigned integer type
+  int32_t offset_;
+};
+
 struct ScheduleInfo
 {
   ScheduleInfo(Tile* t, FlowComponent* flow, uint32_t linesPerTask)
@@ -41,6 +63,8 @@ struct ScheduleInfo
   Tile* tile;
   uint16_t compno;
   std::vector<ShiftInfo> shiftInfo;
+  // empty if samples are written back to the tile buffers
+  std::vector<SampleDest> dest;
   FlowComponent* flow_;
   uint32_t linesPerTask_;
   uint32_t yBegin;
@@ -52,6 +76,14 @@ class mct
 public:
   mct(Tile* tile, GrkImage* image, TileCodingParams* tcp);
 
+  /**
+    Set image that inverse transforms write their samples to, in the image's sample type,
+    once they have been written back to the tile buffers
+    @param dest image with components of the same dimensions as the tile buffers,
+    or nullptr to only write samples back to the tile buffers
+    */
+  void setDestination(GrkImage* dest);
+
   /**
     Apply a reversible multi-component transform to an image
     */
@@ -123,10 +155,12 @@ public:
 private:
   void genShift(uint16_t compno, int32_t sign, std::vector<ShiftInfo>& shiftInfo);
   void genShift(int32_t sign, std::vector<ShiftInfo>& shiftInfo);
+  void genDest(uint16_t compno, std::vector<SampleDest>& dest);
 
   Tile* tile_;
   GrkImage* image_;
   TileCodingParams* tcp_;
+  GrkImage* dest_;
 };
 
 /* ----------------------------------------------------------------------- */
@@ -22,7 +22,8 @@ namespace grk
 CompressScheduler::CompressScheduler(Tile* tile, bool needsRateControl, TileCodingParams* tcp,
                                      const double* mct_norms, uint16_t mct_numcomps)
     : Scheduler(tile), tile(tile), needsRateControl(needsRateControl), encodeBlocks(nullptr),
-      blockCount(-1), tcp_(tcp), mct_norms_(mct_norms), mct_numcomps_(mct_numcomps)
+      blockCount(-1), tcp_(tcp), mct_norms_(mct_norms), mct_numcomps_(mct_numcomps),
+      maxCblkW_(0), maxCblkH_(0)
 {
   for(uint16_t compno = 0; compno < numcomps_; ++compno)
   {
@@ -90,8 +91,8 @@ bool CompressScheduler::scheduleBlocks(uint16_t compno)
       }
     }
   }
-  for(auto i = 0U; i < ExecSingleton::get().num_workers(); ++i)
-    t1Implementations.push_back(T1Factory::makeT1(true, tcp_, maxCblkW, maxCblkH));
+  maxCblkW_ = maxCblkW;
+  maxCblkH_ = maxCblkH;
   compress(&blocks);
 
   return true;
@@ -105,7 +106,7 @@ void CompressScheduler::compress(std::vector<CompressBlockExec*>* blocks)
   size_t num_workers = ExecSingleton::get().num_workers();
   if(num_workers == 1)
   {
-    auto impl = t1Implementations[0];
+    auto impl = T1Factory::getT1(true, tcp_, maxCblkW_, maxCblkH_);
     for(auto iter = blocks->begin(); iter != blocks->end(); ++iter)
     {
       compress(impl, *iter);
@@ -127,20 +128,19 @@ void CompressScheduler::compress(std::vector<CompressBlockExec*>* blocks)
   for(uint64_t i = 0; i < num_workers; i++)
   {
     node[i].work([this, maxBlocks] {
-      auto threadnum = ExecSingleton::get().this_worker_id();
-      while(compress((size_t)threadnum, maxBlocks))
+      auto impl = T1Factory::getT1(true, tcp_, maxCblkW_, maxCblkH_);
+      while(compress(impl, maxBlocks))
       {
       }
     });
   }
-  ExecSingleton::get().run(taskflow).wait();
+  ExecSingleton::run(taskflow);
 
   delete[] node;
   delete[] encodeBlocks;
 }
-bool CompressScheduler::compress(size_t threadId, uint64_t maxBlocks)
+bool CompressScheduler::compress(T1Interface* impl, uint64_t maxBlocks)
 {
-  auto impl = t1Implementations[threadId];
   uint64_t index = (uint64_t)++blockCount;
   if(index >= maxBlocks)
     return false;
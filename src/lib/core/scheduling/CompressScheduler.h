@@ -29,7 +29,7 @@ public:
 private:
   bool scheduleBlocks(uint16_t compno);
   void compress(std::vector<CompressBlockExec*>* blocks);
-  bool compress(size_t threadId, uint64_t maxBlocks);
+  bool compress(T1Interface* impl, uint64_t maxBlocks);
   void compress(T1Interface* impl, CompressBlockExec* block);
 
   Tile* tile;
@@ -40,6 +40,8 @@ private:
   TileCodingParams* tcp_;
   const double* mct_norms_;
   uint16_t mct_numcomps_;
+  uint32_t maxCblkW_;
+  uint32_t maxCblkH_;
 };
 
 } // namespace grk
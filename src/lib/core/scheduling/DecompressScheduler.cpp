@@ -28,18 +28,12 @@ bool ResDecompressBlocks::empty(void) const
 {
   return blocks_.empty();
 }
-void ResDecompressBlocks::release(void)
-{
-  for(const auto& b : blocks_)
-    delete b;
-  blocks_.clear();
-}
 
 DecompressScheduler::DecompressScheduler(TileProcessor* tileProcessor, Tile* tile,
                                          TileCodingParams* tcp, uint8_t prec)
     : Scheduler(tile), tileProcessor_(tileProcessor), tcp_(tcp), prec_(prec),
       numcomps_(tile->numcomps_), tileBlocks_(TileDecompressBlocks(numcomps_)),
-      waveletReverse_(nullptr)
+      waveletReverse_(nullptr), numParsedPrecincts_(numcomps_)
 {
   waveletReverse_ = new WaveletReverse*[numcomps_];
   for(uint16_t compno = 0; compno < numcomps_; ++compno)
@@ -47,6 +41,7 @@ DecompressScheduler::DecompressScheduler(TileProcessor* tileProcessor, Tile* til
 }
 DecompressScheduler::~DecompressScheduler()
 {
+  waitForPrecincts();
   if(waveletReverse_)
   {
     for(uint16_t compno = 0; compno < numcomps_; ++compno)
@@ -81,15 +76,90 @@ bool DecompressScheduler::schedule(uint16_t compno)
 
 void DecompressScheduler::releaseBlocks(uint16_t compno)
 {
-  auto& componentBlocks = tileBlocks_[compno];
-  for(auto& rb : componentBlocks)
-    rb.release();
-  componentBlocks.clear();
+  tileBlocks_[compno].clear();
+}
+bool DecompressScheduler::run(void)
+{
+  waitForPrecincts();
+
+  return Scheduler::run();
+}
+void DecompressScheduler::waitForPrecincts(void)
+{
+  ExecSingleton::wait(precinctTasks_);
+}
+void DecompressScheduler::addBlock(std::vector<DecompressBlockExec>& blocks, uint16_t compno,
+                                   uint8_t resno, uint8_t bandIndex, DecompressCodeblock* cblk)
+{
+  auto tccp = tcp_->tccps + compno;
+  auto tilec = tile_->comps + compno;
+  auto band = tilec->resolutions_[resno].tileBand + bandIndex;
+  auto& block = blocks.emplace_back();
+  block.x = cblk->x0;
+  block.y = cblk->y0;
+  block.tilec = tilec;
+  block.bandIndex = bandIndex;
+  block.bandNumbps = band->numbps;
+  block.bandOrientation = band->orientation;
+  block.cblk = cblk;
+  block.cblk_sty = tccp->cblk_sty;
+  block.qmfbid = tccp->qmfbid;
+  block.resno = resno;
+  block.roishift = tccp->roishift;
+  block.stepsize = band->stepsize;
+  block.k_msbs = (uint8_t)(band->numbps - cblk->numbps);
+  block.R_b = prec_ + gain_b[band->orientation];
+}
+void DecompressScheduler::decompressPrecinct(uint16_t compno, uint8_t resno,
+                                             uint64_t precinctIndex)
+{
+  auto tccp = tcp_->tccps + compno;
+  auto res = tile_->comps[compno].resolutions_ + resno;
+  auto& blocks = precinctBlocks_.emplace_back();
+  for(uint8_t bandIndex = 0; bandIndex < res->numTileBandWindows; ++bandIndex)
+  {
+    auto band = res->tileBand + bandIndex;
+    if(band->empty())
+      continue;
+    auto precinct = band->getPrecinct(precinctIndex);
+    if(!precinct)
+      continue;
+    parsedPrecincts_.insert(precinct);
+    for(uint64_t cblkno = 0; cblkno < precinct->getNumCblks(); ++cblkno)
+      addBlock(blocks, compno, resno, bandIndex, precinct->getDecompressedBlockPtr(cblkno));
+  }
+  if(blocks.empty())
+  {
+    precinctBlocks_.pop_back();
+    return;
+  }
+  numParsedPrecincts_[compno]++;
+
+  // nominal code block dimensions
+  uint16_t codeblock_width = (uint16_t)(tccp->cblkw ? (uint32_t)1 << tccp->cblkw : 0);
+  uint16_t codeblock_height = (uint16_t)(tccp->cblkh ? (uint32_t)1 << tccp->cblkh : 0);
+
+  // a large precinct is shared among workers
+  auto& executor = ExecSingleton::get();
+  size_t numBlocks = blocks.size();
+  size_t numTasks = std::min<size_t>(numBlocks, executor.num_workers());
+  size_t batchSize = (numBlocks + numTasks - 1) / numTasks;
+  auto data = blocks.data();
+  for(size_t begin = 0; begin < numBlocks; begin += batchSize)
+  {
+    auto first = data + begin;
+    auto last = data + std::min<size_t>(begin + batchSize, numBlocks);
+    precinctTasks_.push_back(
+        executor.async([this, first, last, codeblock_width, codeblock_height] {
+          decompressBlocks(nullptr, first, last, codeblock_width, codeblock_height);
+        }));
+  }
 }
 
 bool DecompressScheduler::scheduleBlocks(uint16_t compno)
 {
-  ComponentDecompressBlocks blocks;
+  auto& blocks = tileBlocks_[compno];
+  blocks.clear();
   ResDecompressBlocks resBlocks;
   auto tccp = tcp_->tccps + compno;
   auto tilec = tile_->comps + compno;
@@ -106,36 +176,22 @@ bool DecompressScheduler::scheduleBlocks(uint16_t compno)
       {
         if(!wholeTileDecoding && !paddedBandWindow->nonEmptyIntersection(precinct))
           continue;
+        // already decompressed during T2
+        if(parsedPrecincts_.contains(precinct))
+          continue;
         for(uint64_t cblkno = 0; cblkno < precinct->getNumCblks(); ++cblkno)
         {
           auto cblkBounds = precinct->getCodeBlockBounds(cblkno);
           if(wholeTileDecoding || paddedBandWindow->nonEmptyIntersection(&cblkBounds))
-          {
-            auto cblk = precinct->getDecompressedBlockPtr(cblkno);
-            auto block = new DecompressBlockExec();
-            block->x = cblk->x0;
-            block->y = cblk->y0;
-            block->tilec = tilec;
-            block->bandIndex = bandIndex;
-            block->bandNumbps = band->numbps;
-            block->bandOrientation = band->orientation;
-            block->cblk = cblk;
-            block->cblk_sty = tccp->cblk_sty;
-            block->qmfbid = tccp->qmfbid;
-            block->resno = resno;
-            block->roishift = tccp->roishift;
-            block->stepsize = band->stepsize;
-            block->k_msbs = (uint8_t)(band->numbps - cblk->numbps);
-            block->R_b = prec_ + gain_b[band->orientation];
-            resBlocks.blocks_.push_back(block);
-          }
+            addBlock(resBlocks.blocks_, compno, resno, bandIndex,
+                     precinct->getDecompressedBlockPtr(cblkno));
         }
       }
     }
     // combine first two resolutions together into single resBlock
     if(!resBlocks.blocks_.empty() && resno > 0)
     {
-      blocks.push_back(resBlocks);
+      blocks.push_back(std::move(resBlocks));
       resBlocks.clear();
     }
   }
@@ -144,10 +200,10 @@ bool DecompressScheduler::scheduleBlocks(uint16_t compno)
   if(!resBlocks.empty())
   {
     assert(tilec->highestResolutionDecompressed == 0);
-    blocks.push_back(resBlocks);
+    blocks.push_back(std::move(resBlocks));
     resBlocks.clear();
   }
-  if(blocks.empty())
+  if(blocks.empty() && !numParsedPrecincts_[compno])
     return true;
 
   uint8_t numresolutions = (tile_->comps + compno)->highestResolutionDecompressed + 1;
@@ -158,71 +214,111 @@ bool DecompressScheduler::scheduleBlocks(uint16_t compno)
   // nominal code block dimensions
   uint16_t codeblock_width = (uint16_t)(tccp->cblkw ? (uint32_t)1 << tccp->cblkw : 0);
   uint16_t codeblock_height = (uint16_t)(tccp->cblkh ? (uint32_t)1 << tccp->cblkh : 0);
-  for(auto i = 0U; i < ExecSingleton::get().num_workers(); ++i)
-    t1Implementations.push_back(T1Factory::makeT1(false, tcp_, codeblock_width, codeblock_height));
 
   size_t num_workers = ExecSingleton::get().num_workers();
-  success = true;
+  auto imageFlow = imageComponentFlows_[compno];
   if(num_workers == 1)
   {
     for(auto& rb : blocks)
-    {
-      for(auto& block : rb.blocks_)
-      {
-        if(!success)
-        {
-          delete block;
-        }
-        else
-        {
-          auto impl = t1Implementations[(size_t)0];
-          if(!decompressBlock(impl, block))
-            success = false;
-        }
-      }
-    }
+      decompressBlocks(imageFlow, rb.blocks_.data(), rb.blocks_.data() + rb.blocks_.size(),
+                       codeblock_width, codeblock_height);
+    blocks.clear();
 
     return success;
   }
-  uint8_t resFlowNum = 0;
+  // With the whole tile in memory, higher resolution blocks never overlap the lower
+  // resolution wavelet transform, so horizontal wavelet strips can run as soon as
+  // the code blocks they depend on are decompressed
+  if(wholeTileDecoding && numresolutions > 1)
+    scheduleStrips(compno);
+
+  // Each task decompresses a contiguous run of blocks. Aim for a few tasks per worker
+  // in each resolution, so that load still balances when block decode times vary,
+  // while keeping the task count, and thus graph build and scheduling overhead,
+  // independent of the number of blocks
+  const size_t tasksPerWorker = 4;
   for(auto& rb : blocks)
   {
-    auto resFlow = imageComponentFlows_[compno]->resFlows_ + resFlowNum;
-    for(auto& block : rb.blocks_)
+    // lowest two resolutions are grouped together in first resolution flow, and
+    // a resolution may have no blocks left to schedule
+    uint8_t blockResno = rb.blocks_.front().resno;
+    auto resFlow = imageFlow->getResFlow(blockResno ? (uint8_t)(blockResno - 1) : 0);
+    size_t numBlocks = rb.blocks_.size();
+    size_t numTasks = std::min<size_t>(numBlocks, num_workers * tasksPerWorker);
+    size_t batchSize = (numBlocks + numTasks - 1) / numTasks;
+    auto data = rb.blocks_.data();
+    for(size_t begin = 0; begin < numBlocks; begin += batchSize)
     {
-      resFlow->blocks_->nextTask().work([this, block] {
-        if(!success)
-        {
-          delete block;
-        }
-        else
-        {
-          auto threadnum = ExecSingleton::get().this_worker_id();
-          auto impl = t1Implementations[(size_t)threadnum];
-          if(!decompressBlock(impl, block))
-            success = false;
-        }
-      });
+      auto first = data + begin;
+      auto last = data + std::min<size_t>(begin + batchSize, numBlocks);
+      resFlow->blocks_->nextTask().work(
+          [this, imageFlow, first, last, codeblock_width, codeblock_height] {
+            decompressBlocks(imageFlow, first, last, codeblock_width, codeblock_height);
+          });
     }
-    resFlowNum++;
   }
-  auto& componentBlocks = tileBlocks_[compno];
-  for(auto rb : blocks)
-    componentBlocks.push_back(rb);
 
   return true;
 }
+void DecompressScheduler::scheduleStrips(uint16_t compno)
+{
+  auto tilec = tile_->comps + compno;
+  auto tccp = tcp_->tccps + compno;
+  auto imageFlow = imageComponentFlows_[compno];
+  imageFlow->enableStrips();
+  for(uint8_t resno = 1; resno <= tilec->highestResolutionDecompressed; ++resno)
+  {
+    auto res = tilec->resolutions_ + resno;
+    auto resFlow = imageFlow->getResFlow((uint8_t)(resno - 1));
+    for(uint8_t bandIndex = 0; bandIndex < res->numTileBandWindows; ++bandIndex)
+    {
+      auto band = res->tileBand + bandIndex;
+      // L strips of all but the first resolution flow also wait on the LL band
+      // produced by the previous resolution's vertical pass
+      if(band->orientation == BAND_ORIENT_HL)
+        resFlow->strips_[SPLIT_L].init(band->y0, band->y1, tccp->cblkh, resno > 1);
+      else if(band->orientation == BAND_ORIENT_LH)
+        resFlow->strips_[SPLIT_H].init(band->y0, band->y1, tccp->cblkh, false);
+    }
+  }
+  for(auto& rb : tileBlocks_[compno])
+  {
+    for(auto& block : rb.blocks_)
+    {
+      auto strips = imageFlow->getStrips(block.resno, block.bandOrientation);
+      if(strips)
+        strips->addBlock(block.cblk->y0, block.cblk->y1);
+    }
+  }
+}
+void DecompressScheduler::decompressBlocks(ImageComponentFlow* imageFlow,
+                                           DecompressBlockExec* begin, DecompressBlockExec* end,
+                                           uint16_t cblkw, uint16_t cblkh)
+{
+  auto impl = T1Factory::getT1(false, tcp_, cblkw, cblkh);
+  for(auto block = begin; block != end && success; ++block)
+  {
+    if(!decompressBlock(impl, block))
+    {
+      success = false;
+      break;
+    }
+    if(!imageFlow)
+      continue;
+    // block coordinates are relative after decompression, so use code block bounds
+    auto strips = imageFlow->getStrips(block->resno, block->bandOrientation);
+    if(strips)
+      strips->blockDone(block->cblk->y0, block->cblk->y1);
+  }
+}
 bool DecompressScheduler::decompressBlock(T1Interface* impl, DecompressBlockExec* block)
 {
   try
   {
-    bool rc = block->open(impl);
-    delete block;
-    return rc;
+    return block->open(impl);
   }
   catch(const std::runtime_error& rerr)
   {
-    delete block;
     grklog.error(rerr.what());
     return false;
   }
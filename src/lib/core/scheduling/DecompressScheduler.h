@@ -17,18 +17,24 @@
 
 #pragma once
 
+#include <deque>
+#include <future>
+#include <unordered_set>
+
 #include "grk_includes.h"
 
 namespace grk
 {
+/**
+ * Flat array of block descriptors for one resolution flow
+ */
 struct ResDecompressBlocks
 {
   ResDecompressBlocks(void) = default;
   void clear(void);
   bool empty(void) const;
-  void release(void);
 
-  std::vector<DecompressBlockExec*> blocks_;
+  std::vector<DecompressBlockExec> blocks_;
 };
 
 typedef std::vector<ResDecompressBlocks> ComponentDecompressBlocks;
@@ -42,18 +48,40 @@ public:
   ~DecompressScheduler();
 
   bool schedule(uint16_t compno) override;
+  bool run(void) override;
+
+  /**
+   * @brief Launches decompression of the code blocks of a precinct whose packets
+   * have all been parsed, so that T1 overlaps T2 for the rest of the tile.
+   *
+   * Called from T2, for whole tile decompression only.
+   * These blocks are then skipped when the component is scheduled.
+   */
+  void decompressPrecinct(uint16_t compno, uint8_t resno, uint64_t precinctIndex);
 
 private:
+  void addBlock(std::vector<DecompressBlockExec>& blocks, uint16_t compno, uint8_t resno,
+                uint8_t bandIndex, DecompressCodeblock* cblk);
   bool scheduleBlocks(uint16_t compno);
+  void scheduleStrips(uint16_t compno);
   bool scheduleWavelet(uint16_t compno);
   bool decompressBlock(T1Interface* impl, DecompressBlockExec* block);
+  void decompressBlocks(ImageComponentFlow* imageFlow, DecompressBlockExec* begin,
+                        DecompressBlockExec* end, uint16_t cblkw, uint16_t cblkh);
   void releaseBlocks(uint16_t compno);
+  void waitForPrecincts(void);
   TileProcessor* tileProcessor_;
   TileCodingParams* tcp_;
   uint8_t prec_;
   uint16_t numcomps_;
   TileDecompressBlocks tileBlocks_;
   WaveletReverse** waveletReverse_;
+
+  // precincts decompressed while T2 is still running
+  std::unordered_set<const Precinct*> parsedPrecincts_;
+  std::vector<uint64_t> numParsedPrecincts_;
+  std::deque<std::vector<DecompressBlockExec>> precinctBlocks_;
+  std::vector<std::future<void>> precinctTasks_;
 };
 
 } // namespace grk
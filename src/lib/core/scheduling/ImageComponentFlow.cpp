@@ -18,9 +18,90 @@
 
 namespace grk
 {
+WaveletStrips::WaveletStrips(void)
+    : numStrips_(0), bandY0_(0), bandY1_(0), log2StripHeight_(0), waitForLL_(false)
+{}
+void WaveletStrips::init(uint32_t bandY0, uint32_t bandY1, uint8_t log2StripHeight,
+                         bool waitForLL)
+{
+  bandY0_ = bandY0;
+  bandY1_ = bandY1;
+  log2StripHeight_ = log2StripHeight;
+  waitForLL_ = waitForLL;
+  numStrips_ = 0;
+  if(bandY1_ > bandY0_)
+    numStrips_ = ((bandY1_ - 1) >> log2StripHeight_) - (bandY0_ >> log2StripHeight_) + 1;
+  strips_ = numStrips_ ? std::make_unique<Strip[]>(numStrips_) : nullptr;
+  for(uint32_t i = 0; i < numStrips_; ++i)
+    strips_[i].pending_ = waitForLL_ ? 1 : 0;
+}
+uint32_t WaveletStrips::size(void) const
+{
+  return numStrips_;
+}
+grk_line32 WaveletStrips::getRows(uint32_t stripno) const
+{
+  uint64_t y0 = ((uint64_t)(bandY0_ >> log2StripHeight_) + stripno) << log2StripHeight_;
+  uint64_t y1 = y0 + ((uint64_t)1 << log2StripHeight_);
+
+  return grk_line32((uint32_t)std::max<uint64_t>(y0, bandY0_) - bandY0_,
+                    (uint32_t)std::min<uint64_t>(y1, bandY1_) - bandY0_);
+}
+void WaveletStrips::setStrip(uint32_t stripno, std::function<void()>&& exec)
+{
+  assert(stripno < numStrips_);
+  strips_[stripno].exec_ = std::move(exec);
+}
+bool WaveletStrips::overlap(uint32_t y0, uint32_t y1, uint32_t& first, uint32_t& last) const
+{
+  y0 = std::max(y0, bandY0_);
+  y1 = std::min(y1, bandY1_);
+  if(y0 >= y1)
+    return false;
+  first = (y0 >> log2StripHeight_) - (bandY0_ >> log2StripHeight_);
+  last = ((y1 - 1) >> log2StripHeight_) - (bandY0_ >> log2StripHeight_);
+
+  return true;
+}
+void WaveletStrips::addBlock(uint32_t y0, uint32_t y1)
+{
+  uint32_t first, last;
+  if(!overlap(y0, y1, first, last))
+    return;
+  for(uint32_t i = first; i <= last; ++i)
+  {
+    strips_[i].numBlocks_++;
+    strips_[i].pending_++;
+  }
+}
+void WaveletStrips::blockDone(uint32_t y0, uint32_t y1)
+{
+  uint32_t first, last;
+  if(!overlap(y0, y1, first, last))
+    return;
+  for(uint32_t i = first; i <= last; ++i)
+  {
+    auto strip = strips_.get() + i;
+    if(strip->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1 && strip->exec_)
+      strip->exec_();
+  }
+}
+void WaveletStrips::release(tf::Runtime& rt)
+{
+  for(uint32_t i = 0; i < numStrips_; ++i)
+  {
+    auto strip = strips_.get() + i;
+    // strips without code blocks are never triggered by a block
+    bool ready = waitForLL_ ? strip->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1
+                            : strip->numBlocks_ == 0;
+    if(ready && strip->exec_)
+      rt.silent_async([strip] { strip->exec_(); });
+  }
+}
+
 ResFlow::ResFlow(void)
     : packets_(nullptr), blocks_(new FlowComponent()), waveletHoriz_(new FlowComponent()),
-      waveletVert_(new FlowComponent()), doWavelet_(true)
+      waveletVert_(new FlowComponent()), doWavelet_(true), doStrips_(false)
 {}
 FlowComponent* ResFlow::getPacketsFlow(void)
 {
@@ -36,13 +117,34 @@ void ResFlow::disableWavelet(void)
 {
   doWavelet_ = false;
 }
+void ResFlow::enableStrips(void)
+{
+  doStrips_ = doWavelet_;
+}
+bool ResFlow::stripsEnabled(void) const
+{
+  return doStrips_;
+}
 void ResFlow::graph(void)
 {
-  if(doWavelet_)
+  if(!doWavelet_)
+    return;
+  if(doStrips_)
+  {
+    // horizontal strips are triggered by the blocks they depend on, so blocks
+    // only need to complete before the vertical pass
+    blocks_->precede(waveletVert_);
+    waveletHoriz_->nextTask().work([this](tf::Runtime& rt) {
+      for(auto& strips : strips_)
+        strips.release(rt);
+      rt.corun_all();
+    });
+  }
+  else
   {
     blocks_->precede(waveletHoriz_);
-    waveletHoriz_->precede(waveletVert_);
   }
+  waveletHoriz_->precede(waveletVert_);
 }
 ResFlow* ResFlow::addTo(tf::Taskflow& composition)
 {
@@ -62,7 +164,14 @@ ResFlow* ResFlow::precede(ResFlow* successor)
 {
   assert(successor);
   if(doWavelet_)
-    waveletVert_->precede(successor->blocks_);
+  {
+    // with strips, higher resolution blocks overlap lower resolution wavelet,
+    // and only the horizontal pass waits on the previous resolution's LL band
+    if(successor->doStrips_)
+      waveletVert_->precede(successor->waveletHoriz_);
+    else
+      waveletVert_->precede(successor->blocks_);
+  }
 
   return this;
 }
@@ -113,6 +222,22 @@ void ImageComponentFlow::setRegionDecompression(void)
 {
   waveletFinalCopy_ = new FlowComponent();
 }
+void ImageComponentFlow::enableStrips(void)
+{
+  for(uint8_t i = 0; i < numResFlows_; ++i)
+    (resFlows_ + i)->enableStrips();
+}
+WaveletStrips* ImageComponentFlow::getStrips(uint8_t resno, eBandOrientation orientation)
+{
+  // lowest two resolutions are grouped together in first resolution flow
+  auto resFlow = getResFlow(resno ? (uint8_t)(resno - 1) : 0);
+  if(!resFlow || !resFlow->stripsEnabled())
+    return nullptr;
+
+  return resFlow->strips_ + ((orientation == BAND_ORIENT_LL || orientation == BAND_ORIENT_HL)
+                                 ? 0
+                                 : 1);
+}
 void ImageComponentFlow::graph(void)
 {
   for(uint8_t i = 0; i < numResFlows_; ++i)
@@ -21,6 +21,53 @@
 
 namespace grk
 {
+/**
+ * Row strips of one horizontal wavelet split (L or H) of a resolution
+ *
+ * Strips are aligned to the code block grid of the split's bands, so that each strip
+ * depends on a single row of code blocks. A strip runs as soon as the last of its
+ * code blocks has been decompressed, on the thread that decompressed that block.
+ * Strips of an L split may also wait on the LL band produced by the vertical pass
+ * of the previous resolution: this dependency is released by the release task of
+ * the resolution's horizontal wavelet component.
+ */
+class WaveletStrips
+{
+public:
+  WaveletStrips(void);
+  void init(uint32_t bandY0, uint32_t bandY1, uint8_t log2StripHeight, bool waitForLL);
+  uint32_t size(void) const;
+  /**
+   * @brief Gets strip rows, relative to top of split
+   */
+  grk_line32 getRows(uint32_t stripno) const;
+  void setStrip(uint32_t stripno, std::function<void()>&& exec);
+  /**
+   * @brief Adds code block spanning band rows [y0,y1) to dependencies
+   */
+  void addBlock(uint32_t y0, uint32_t y1);
+  /**
+   * @brief Notifies that code block spanning band rows [y0,y1) has been decompressed
+   */
+  void blockDone(uint32_t y0, uint32_t y1);
+  void release(tf::Runtime& rt);
+
+private:
+  struct Strip
+  {
+    std::atomic<uint32_t> pending_ = 0;
+    uint32_t numBlocks_ = 0;
+    std::function<void()> exec_;
+  };
+  bool overlap(uint32_t y0, uint32_t y1, uint32_t& first, uint32_t& last) const;
+  std::unique_ptr<Strip[]> strips_;
+  uint32_t numStrips_;
+  uint32_t bandY0_;
+  uint32_t bandY1_;
+  uint8_t log2StripHeight_;
+  bool waitForLL_;
+};
+
 struct ResFlow
 {
   ResFlow(void);
@@ -28,6 +75,8 @@ struct ResFlow
 
   FlowComponent* getPacketsFlow(void);
   void disableWavelet(void);
+  void enableStrips(void);
+  bool stripsEnabled(void) const;
   void graph(void);
   ResFlow* addTo(tf::Taskflow& composition);
   ResFlow* precede(ResFlow* successor);
@@ -37,7 +86,9 @@ struct ResFlow
   FlowComponent* blocks_;
   FlowComponent* waveletHoriz_;
   FlowComponent* waveletVert_;
+  WaveletStrips strips_[2]; // L and H splits
   bool doWavelet_;
+  bool doStrips_;
 };
 
 class ImageComponentFlow
@@ -46,6 +97,8 @@ public:
   ImageComponentFlow(uint8_t numresolutions);
   virtual ~ImageComponentFlow(void);
   void setRegionDecompression(void);
+  void enableStrips(void);
+  WaveletStrips* getStrips(uint8_t resno, eBandOrientation orientation);
   std::string genBlockFlowTaskName(uint8_t resFlowNo);
   ResFlow* getResFlow(uint8_t resFlowNo);
   void graph(void);
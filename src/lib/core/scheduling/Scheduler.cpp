@@ -35,16 +35,18 @@ Scheduler::~Scheduler()
   for(uint16_t compno = 0; compno < numcomps_; ++compno)
     delete imageComponentFlows_[compno];
   delete[] imageComponentFlows_;
-  for(const auto& t : t1Implementations)
-    delete t;
   delete prePostProc_;
 }
 bool Scheduler::run(void)
 {
-  ExecSingleton::get().run(codecFlow_).wait();
+  ExecSingleton::run(codecFlow_);
 
   return success;
 }
+void Scheduler::setFailed(void)
+{
+  success = false;
+}
 void Scheduler::graph(uint16_t compno)
 {
   assert(compno < numcomps_);
@@ -26,14 +26,17 @@ public:
 
   virtual bool schedule(uint16_t compno) = 0;
   void graph(uint16_t compno);
-  bool run(void);
+  virtual bool run(void);
   ImageComponentFlow* getImageComponentFlow(uint16_t compno);
   tf::Taskflow& getCodecFlow(void);
   FlowComponent* getPrePostProc(void);
+  /**
+   * @brief Flags failure of a task that cannot report it through the task graph
+   */
+  void setFailed(void);
 
 protected:
   std::atomic_bool success;
-  std::vector<T1Interface*> t1Implementations;
   ImageComponentFlow** imageComponentFlows_;
   tf::Taskflow codecFlow_;
   Tile* tile_;
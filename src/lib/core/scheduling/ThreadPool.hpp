@@ -45,16 +45,7 @@ public:
   static void create(uint32_t numThreads)
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    numThreads = numThreads ? numThreads : std::thread::hardware_concurrency() + 1;
-    if(numThreads_ == numThreads)
-      return;
-    numThreads_ = numThreads;
-    if(numThreads_ == 1)
-    {
-      instance_.reset();
-      return;
-    }
-    instance_ = std::make_unique<tf::Executor>(numThreads_ - 1);
+    createImpl(numThreads);
   }
 
   /**
@@ -65,10 +56,52 @@ public:
   {
     std::lock_guard<std::mutex> lock(mutex_);
     if(!instance_)
-      create(0);
+      createImpl(0);
     return *instance_;
   }
 
+  /**
+   * @brief Runs a taskflow on the singleton executor and waits for it to complete.
+   *
+   * When called from one of the executor's own workers (i.e. from a task that is itself
+   * running on the executor), the calling worker co-runs the taskflow instead of blocking,
+   * so taskflows may be nested (tile -> code blocks -> wavelet) on the one work-stealing pool
+   * without starving it of workers.
+   * @param taskflow taskflow to run
+   */
+  static void run(tf::Taskflow& taskflow)
+  {
+    auto& executor = get();
+    if(executor.this_worker_id() >= 0)
+      executor.corun(taskflow);
+    else
+      executor.run(taskflow).wait();
+  }
+
+  /**
+   * @brief Waits for asynchronous tasks launched on the singleton executor.
+   *
+   * As with run(), a calling worker co-runs other tasks while it waits, rather than blocking.
+   * @param futures futures of tasks to wait for; cleared on return
+   */
+  static void wait(std::vector<std::future<void>>& futures)
+  {
+    auto& executor = get();
+    if(executor.this_worker_id() >= 0)
+    {
+      size_t numReady = 0;
+      executor.corun_until([&futures, &numReady] {
+        while(numReady < futures.size() &&
+              futures[numReady].wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+          numReady++;
+        return numReady == futures.size();
+      });
+    }
+    for(auto& f : futures)
+      f.wait();
+    futures.clear();
+  }
+
   /**
    * @brief Gets total number of threads
    *
@@ -98,6 +131,21 @@ public:
   }
 
 private:
+  /**
+   * @brief Creates singleton instance; caller must hold mutex_
+   * @param numThreads total number of threads including main thread
+   */
+  static void createImpl(uint32_t numThreads)
+  {
+    numThreads = numThreads ? numThreads : std::thread::hardware_concurrency() + 1;
+    if(instance_ && numThreads_ == numThreads)
+      return;
+    numThreads_ = numThreads;
+    // a single threaded executor still has one worker, so that taskflows can always be run;
+    // callers check num_workers() and process inline when there is only one worker
+    instance_ = std::make_unique<tf::Executor>(std::max<size_t>(numThreads_ - 1, 1));
+  }
+
   // Deleted copy constructor and assignment operator
   ExecSingleton(const ExecSingleton&) = delete;
   ExecSingleton& operator=(const ExecSingleton&) = delete;
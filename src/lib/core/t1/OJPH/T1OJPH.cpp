@@ -122,25 +122,40 @@ bool T1OJPH::decompress(grk::DecompressBlockExec* block)
   auto cblk = block->cblk;
   if(!cblk->area())
     return true;
-  uint16_t stride = (uint16_t)cblk->width();
+  // cleanup pass decodes rows in pairs, so a block with odd height
+  // would overwrite the window row below it
+  uint32_t destStride = 0;
+  int32_t* dest = nullptr;
+  if(!(cblk->height() & 1))
+    dest = block->tilec->getDirectDest(block, destStride);
+  uint32_t stride = dest ? destStride : cblk->width();
+  auto decoded = dest ? dest : unencoded_data;
   if(!cblk->seg_buffers.empty())
   {
-    size_t total_seg_len = 2 * grk_cblk_dec_compressed_data_pad_ht + cblk->getSegBuffersLen();
-    if(coded_data_size < total_seg_len)
-    {
-      delete[] coded_data;
-      coded_data = new uint8_t[total_seg_len];
-      coded_data_size = (uint32_t)total_seg_len;
-      memset(coded_data, 0, grk_cblk_dec_compressed_data_pad_ht);
-    }
-    memset(coded_data + grk_cblk_dec_compressed_data_pad_ht + cblk->getSegBuffersLen(), 0,
-           grk_cblk_dec_compressed_data_pad_ht);
-    uint8_t* actual_coded_data = coded_data + grk_cblk_dec_compressed_data_pad_ht;
+    // the block decoder never writes to its input, so contiguous packet data
+    // with readable padding in its chunk is decoded in place. Otherwise,
+    // the segments are copied into a padded buffer
     size_t offset = 0;
-    for(auto& b : cblk->seg_buffers)
+    uint8_t* actual_coded_data =
+        cblk->getContiguousSegBuffers(grk_cblk_dec_compressed_data_pad_ht, offset);
+    if(!actual_coded_data)
     {
-      memcpy(actual_coded_data + offset, b->buf, b->len);
-      offset += b->len;
+      size_t total_seg_len = 2 * grk_cblk_dec_compressed_data_pad_ht + cblk->getSegBuffersLen();
+      if(coded_data_size < total_seg_len)
+      {
+        delete[] coded_data;
+        coded_data = new uint8_t[total_seg_len];
+        coded_data_size = (uint32_t)total_seg_len;
+        memset(coded_data, 0, grk_cblk_dec_compressed_data_pad_ht);
+      }
+      memset(coded_data + grk_cblk_dec_compressed_data_pad_ht + cblk->getSegBuffersLen(), 0,
+             grk_cblk_dec_compressed_data_pad_ht);
+      actual_coded_data = coded_data + grk_cblk_dec_compressed_data_pad_ht;
+      for(auto& b : cblk->seg_buffers)
+      {
+        memcpy(actual_coded_data + offset, b->buf, b->len);
+        offset += b->len;
+      }
     }
 
     size_t num_passes = 0;
@@ -153,11 +168,11 @@ bool T1OJPH::decompress(grk::DecompressBlockExec* block)
     bool rc = false;
     if(num_passes && offset)
     {
-      rc = ojph::local::ojph_decode_codeblock(actual_coded_data, (uint32_t*)unencoded_data,
+      rc = ojph::local::ojph_decode_codeblock(actual_coded_data, (uint32_t*)decoded,
                                               block->k_msbs, (uint32_t)num_passes, (uint32_t)offset,
                                               0, cblk->width(), cblk->height(), stride, false);
     }
-    else
+    else if(!dest)
     {
       memset(unencoded_data, 0, stride * cblk->height() * sizeof(int32_t));
     }
@@ -166,9 +181,11 @@ bool T1OJPH::decompress(grk::DecompressBlockExec* block)
       grk::grklog.error("Error in HT block coder");
       return false;
     }
+    if(dest)
+      block->tilec->postProcessDirectHT(dest, destStride, block);
   }
-
-  block->tilec->postProcessHT(unencoded_data, block, stride);
+  if(!dest)
+    block->tilec->postProcessHT(unencoded_data, block, (uint16_t)stride);
 
   return true;
 }
@@ -15,6 +15,9 @@
  *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *
  */
+#include <memory>
+#include <unordered_map>
+
 #include "simd.h"
 #include "grk_includes.h"
 #include "T1Part1.h"
@@ -31,6 +34,21 @@ T1Interface* T1Factory::makeT1(bool isCompressor, TileCodingParams* tcp, uint32_
     return new t1_part1::T1Part1(isCompressor, maxCblkW, maxCblkH);
 }
 
+T1Interface* T1Factory::getT1(bool isCompressor, TileCodingParams* tcp, uint32_t maxCblkW,
+                              uint32_t maxCblkH)
+{
+  // key: compressor flag, HT flag and maximum code block dimensions
+  // (code block dimensions are at most 1024, and are powers of two for decompression)
+  uint64_t key = ((uint64_t)isCompressor << 63) | ((uint64_t)tcp->isHT() << 62) |
+                 ((uint64_t)maxCblkW << 32) | maxCblkH;
+  thread_local std::unordered_map<uint64_t, std::unique_ptr<T1Interface>> pool;
+  auto& t1 = pool[key];
+  if(!t1)
+    t1.reset(makeT1(isCompressor, tcp, maxCblkW, maxCblkH));
+
+  return t1.get();
+}
+
 Quantizer* T1Factory::makeQuantizer(bool ht, bool reversible, uint8_t guardBits)
 {
   if(ht)
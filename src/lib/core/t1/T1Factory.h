@@ -26,6 +26,15 @@ class T1Factory
 public:
   static T1Interface* makeT1(bool isCompressor, TileCodingParams* tcp, uint32_t maxCblkW,
                              uint32_t maxCblkH);
+  /**
+   * Get T1 coder owned by the calling thread, creating it on first use.
+   *
+   * Coders are pooled per thread, keyed by coder type and maximum code block size,
+   * and live as long as the thread, so worker threads reuse them across tiles and
+   * codec instances. The returned coder must only be used by the calling thread.
+   */
+  static T1Interface* getT1(bool isCompressor, TileCodingParams* tcp, uint32_t maxCblkW,
+                            uint32_t maxCblkH);
   static Quantizer* makeQuantizer(bool ht, bool reversible, uint8_t guardBits);
 };
 
@@ -141,8 +141,19 @@ namespace t1_part1
   bool T1Part1::decompress(DecompressBlockExec* block)
   {
     auto cblk = block->cblk;
-    cblk->alloc2d(true);
-    t1->attachUncompressedData(cblk->getBuffer(), cblk->width(), cblk->height());
+    // in whole tile mode, decompress directly into the zeroed tile component window
+    uint32_t destStride = 0;
+    auto dest = block->tilec->getDirectDest(block, destStride);
+    if(dest)
+    {
+      t1->attachUncompressedData(dest, cblk->width(), cblk->height(), destStride);
+    }
+    else
+    {
+      cblk->alloc2d(true);
+      t1->attachUncompressedData(cblk->getBuffer(), cblk->width(), cblk->height(), cblk->width());
+    }
+    bool decompressed = false;
     if(cblk->isClosed())
     {
       if(!cblk->seg_buffers.empty())
@@ -161,10 +172,19 @@ namespace t1_part1
         cblk->setCacheState(ret ? GRK_CACHE_STATE_OPEN : GRK_CACHE_STATE_ERROR);
         if(!ret)
           return false;
+        decompressed = true;
       }
     }
 
-    block->tilec->postProcess(t1->getUncompressedData(), block);
+    if(dest)
+    {
+      if(decompressed)
+        block->tilec->postProcessDirect(dest, destStride, block);
+    }
+    else
+    {
+      block->tilec->postProcess(t1->getUncompressedData(), block);
+    }
     cblk->release();
 
     return true;
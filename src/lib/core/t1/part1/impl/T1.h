@@ -43,7 +43,7 @@ struct T1
   mqcoder coder;
 
   int32_t* getUncompressedData(void);
-  void attachUncompressedData(int32_t* data, uint32_t w, uint32_t h);
+  void attachUncompressedData(int32_t* data, uint32_t w, uint32_t h, uint32_t stride);
   void allocCompressedData(size_t len);
   uint8_t* getCompressedDataBuffer(void);
   static double getnorm(uint32_t level, uint8_t orientation, bool reversible);
@@ -395,7 +395,7 @@ void PacketParser::readData(void)
         {
           // HT doesn't tolerate truncated code blocks since decoding runs both forward
           // and reverse. So, in this case, we ignore the entire code block
-          if(tileProcessor_->cp_->tcps[0].isHT())
+          if(tileProcessor_->getTileCodingParams()->isHT())
             cblk->cleanUpSegBuffers();
           seg->numBytesInPacket = 0;
           seg->numpasses = 0;
@@ -414,7 +414,8 @@ void PacketParser::readData(void)
           // correct for truncated packet
           if(seg->numBytesInPacket > remainingTilePartBytes_)
             seg->numBytesInPacket = (uint32_t)remainingTilePartBytes_;
-          cblk->seg_buffers.push_back(new grk_buf8(data_ + offset, seg->numBytesInPacket, false));
+          cblk->addSegBuffer(data_ + offset, seg->numBytesInPacket,
+                             remainingTilePartBytes_ - seg->numBytesInPacket);
           offset += seg->numBytesInPacket;
           cblk->compressedStream.len += seg->numBytesInPacket;
           seg->len += seg->numBytesInPacket;
@@ -464,8 +465,9 @@ PrecinctPacketParsers::PrecinctPacketParsers(TileProcessor* tileProcessor)
 
 PrecinctPacketParsers::~PrecinctPacketParsers(void)
 {
+  // parsers are only pushed when deferred, and deferred parsers live in the tile arena
   for(uint16_t i = 0; i < numParsers_; ++i)
-    delete parsers_[i];
+    arenaDelete(tileProcessor_->getArena(), parsers_[i]);
   delete[] parsers_;
 }
 
@@ -484,9 +486,14 @@ void PrecinctPacketParsers::pushParser(PacketParser* parser)
 ParserMap::ParserMap(TileProcessor* tileProcessor) : tileProcessor_(tileProcessor) {}
 
 ParserMap::~ParserMap()
+{
+  clear();
+}
+void ParserMap::clear(void)
 {
   for(const auto& p : precinctParsers_)
     delete p.second;
+  precinctParsers_.clear();
 }
 
 void ParserMap::pushParser(uint64_t precinctIndex, PacketParser* parser)
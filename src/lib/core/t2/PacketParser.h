@@ -79,6 +79,7 @@ struct ParserMap
   ParserMap(TileProcessor* tileProcessor);
   ~ParserMap();
   void pushParser(uint64_t precinctIndex, PacketParser* parser);
+  void clear(void);
 
   TileProcessor* tileProcessor_;
   std::map<uint64_t, PrecinctPacketParsers*> precinctParsers_;
@@ -22,7 +22,9 @@
 
 namespace grk
 {
-T2Decompress::T2Decompress(TileProcessor* tileProc) : tileProcessor(tileProc) {}
+T2Decompress::T2Decompress(TileProcessor* tileProc, DecompressScheduler* scheduler)
+    : tileProcessor(tileProc), scheduler_(scheduler)
+{}
 
 void T2Decompress::decompressPackets(uint16_t tile_no, SparseBuffer* src,
                                      bool* stopProcessionPackets)
@@ -35,6 +37,21 @@ void T2Decompress::decompressPackets(uint16_t tile_no, SparseBuffer* src,
   auto markers = tileProcessor->packetLengthCache.getMarkers();
   if(markers && !markers->isEnabled())
     markers = nullptr;
+  // Packed packet headers must be read in codestream order
+  if(cp->ppm_marker || tcp->ppt)
+    markers = nullptr;
+  // Packet lengths must be known for every packet, otherwise a precinct's packet headers
+  // could be parsed out of order
+  if(markers && markers->getNumPacketLengths() < getNumPackets())
+  {
+    grklog.warn("PLT markers for tile %u are incomplete and will be ignored", tile_no);
+    markers = nullptr;
+  }
+  if(markers)
+    markers->rewind();
+  bool recordPacketLengths = tileProcessor->recordPacketLengths_ && !markers;
+  uint64_t numPackets = 0;
+  tileProcessor->packetLengths_.clear();
   for(uint32_t pino = 0; pino < tcp->getNumProgressions(); ++pino)
   {
     auto currPi = packetManager.getPacketIter(pino);
@@ -49,11 +66,12 @@ void T2Decompress::decompressPackets(uint16_t tile_no, SparseBuffer* src,
       try
       {
         if(!processPacket(currPi->getCompno(), currPi->getResno(), currPi->getPrecinctIndex(),
-                          currPi->getLayno(), src))
+                          currPi->getLayno(), markers ? markers->pop() : 0, src))
         {
           *stopProcessionPackets = true;
           break;
         }
+        numPackets++;
       }
       catch([[maybe_unused]] const TruncatedPacketHeaderException& tex)
       {
@@ -67,7 +85,7 @@ void T2Decompress::decompressPackets(uint16_t tile_no, SparseBuffer* src,
       catch([[maybe_unused]] const CorruptPacketException& cex)
       {
         // we can skip corrupt packet if PLT markers are present
-        if(!tileProcessor->packetLengthCache.getMarkers())
+        if(!markers)
         {
           grklog.warn("Corrupt packet: tile=%u component=%02d resolution=%02d precinct=%03d "
                       "layer=%02d",
@@ -89,13 +107,33 @@ void T2Decompress::decompressPackets(uint16_t tile_no, SparseBuffer* src,
     if(*stopProcessionPackets)
       break;
   }
+  // recorded lengths are only of use if every packet of the tile was parsed
+  if(!recordPacketLengths || *stopProcessionPackets || numPackets != getNumPackets())
+    tileProcessor->packetLengths_.clear();
 }
 
+uint64_t T2Decompress::getNumPackets(void)
+{
+  auto tile = tileProcessor->getTile();
+  uint64_t numPrecincts = 0;
+  for(uint16_t compno = 0; compno < tile->numcomps_; ++compno)
+  {
+    auto tilec = tile->comps + compno;
+    for(uint8_t resno = 0; resno < tilec->numresolutions; ++resno)
+    {
+      auto res = tilec->resolutions_ + resno;
+      numPrecincts += (uint64_t)res->precinctGridWidth * res->precinctGridHeight;
+    }
+  }
+
+  return numPrecincts * tileProcessor->getTileCodingParams()->num_layers_;
+}
 bool T2Decompress::processPacket(uint16_t compno, uint8_t resno, uint64_t precinctIndex,
-                                 uint16_t layno, SparseBuffer* src)
+                                 uint16_t layno, uint32_t packetLength, SparseBuffer* src)
 {
-  // read from PL marker, if available
+  // packet length from PL marker, if available
   PacketInfo p;
+  p.packetLength = packetLength;
   auto packetInfo = &p;
   auto tilec = tileProcessor->getTile()->comps + compno;
   auto res = tilec->resolutions_ + resno;
@@ -132,10 +170,12 @@ bool T2Decompress::processPacket(uint16_t compno, uint8_t resno, uint64_t precin
         return false;
     }
   }
-  auto parser =
-      new PacketParser(tileProcessor, tileProcessor->getNumProcessedPackets() & 0xFFFF, compno,
-                       resno, precinctIndex, layno, src->getCurrentChunkPtr(),
-                       packetInfo->packetLength, src->totalLength(), src->getCurrentChunkLength());
+  // deferred parsers live until the tile is released, so they are allocated from the tile arena
+  auto arena = (!skip && packetInfo->packetLength) ? tileProcessor->getArena() : nullptr;
+  auto parser = arenaNew<PacketParser>(
+      arena, tileProcessor, (uint16_t)(tileProcessor->getNumProcessedPackets() & 0xFFFF), compno,
+      resno, precinctIndex, layno, src->getCurrentChunkPtr(), packetInfo->packetLength,
+      src->totalLength(), src->getCurrentChunkLength());
   uint32_t packetLen = packetInfo->packetLength;
   if(!packetInfo->packetLength)
   {
@@ -145,10 +185,12 @@ bool T2Decompress::processPacket(uint16_t compno, uint8_t resno, uint64_t precin
     }
     catch([[maybe_unused]] const std::exception& ex)
     {
-      delete parser;
+      arenaDelete(arena, parser);
       throw;
     }
     packetLen = parser->numHeaderBytes() + parser->numSignalledDataBytes();
+    if(tileProcessor->recordPacketLengths_)
+      CodeStreamIndex::pushPacketLength(tileProcessor->packetLengths_, packetLen);
   }
   try
   {
@@ -156,14 +198,19 @@ bool T2Decompress::processPacket(uint16_t compno, uint8_t resno, uint64_t precin
   }
   catch([[maybe_unused]] const SparseBufferOverrunException& sboe)
   {
-    delete parser;
+    arenaDelete(arena, parser);
     return false;
   }
   if(skip)
-    delete parser;
+    arenaDelete(arena, parser);
   else
     readPacketData(res, parser, precinctIndex, packetInfo->packetLength);
   tileProcessor->incNumProcessedPackets();
+  // Packet headers of a precinct keep updating its code blocks until the final layer,
+  // even for layers that are not decompressed: only then can the blocks be decompressed
+  if(scheduler_ && !packetInfo->packetLength && layno + 1U == tcp->num_layers_ &&
+     resno < tilec->numResolutionsToDecompress)
+    scheduler_->decompressPrecinct(compno, resno, precinctIndex);
 
   return true;
 }
@@ -21,21 +21,39 @@
 namespace grk
 {
 struct TileProcessor;
+class DecompressScheduler;
 
 /**
  Tier-2 decoding
  */
 struct T2Decompress
 {
-  T2Decompress(TileProcessor* tileProc);
+  /**
+   * @brief Creates a T2Decompress
+   * @param tileProc tile processor
+   * @param scheduler if not null, notified of each precinct whose packets have all been parsed
+   */
+  T2Decompress(TileProcessor* tileProc, DecompressScheduler* scheduler);
   virtual ~T2Decompress(void) = default;
   void decompressPackets(uint16_t tileno, SparseBuffer* src, bool* truncated);
 
 private:
   TileProcessor* tileProcessor;
+  DecompressScheduler* scheduler_;
   void decompressPacket(PacketParser* parser, bool skipData);
+  /**
+   * @brief Processes a packet
+   *
+   * If the packet length is known from a PL marker, the packet is skipped over, and
+   * its parser is deferred, to be run later together with the other packets of its precinct.
+   * @param packetLength packet length from PL marker, or zero if not known
+   */
   bool processPacket(uint16_t compno, uint8_t resno, uint64_t precinctIndex, uint16_t layno,
-                     SparseBuffer* src);
+                     uint32_t packetLength, SparseBuffer* src);
+  /**
+   * @brief Gets total number of packets in tile
+   */
+  uint64_t getNumPackets(void);
   void readPacketData(Resolution* res, PacketParser* parser, uint64_t precinctIndex, bool defer);
 };
 
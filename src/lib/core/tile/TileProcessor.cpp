@@ -26,17 +26,23 @@ TileProcessor::TileProcessor(uint16_t tile_index, CodeStream* codeStream, Buffer
     : first_poc_tile_part_(true), tilePartCounter_(0), pino(0),
       headerImage(codeStream->getHeaderImage()),
       current_plugin_tile(codeStream->getCurrentPluginTile()), cp_(codeStream->getCodingParams()),
-      packetLengthCache(PLCache()), tile(new Tile(headerImage->numcomps)), scheduler_(nullptr),
+      packetLengthCache(PLCache()), recordPacketLengths_(false),
+      tile(new Tile(headerImage->numcomps)), scheduler_(nullptr),
       numProcessedPackets(0), numDecompressedPackets(0), tilePartDataLength(0),
       tileIndex_(tile_index), stream_(stream), corrupt_packet_(false),
       newTilePartProgressionPosition(cp_->coding_params_.enc_.newTilePartProgressionPosition),
       tcp_(cp_->tcps + tileIndex_), truncated(false), image_(nullptr), isCompressor_(isCompressor),
-      preCalculatedTileLen(0), mct_(new mct(tile, headerImage, tcp_))
+      preCalculatedTileLen(0), mct_(new mct(tile, headerImage, tcp_)),
+      arenaPool_(codeStream->getArenaPool()), arena_(nullptr),
+      memTracker_(codeStream->getMemoryTracker()), windowBytes_(0), t1Bytes_(0),
+      memoryFootprint_(0)
 {}
 TileProcessor::~TileProcessor()
 {
-  release(GRK_TILE_CACHE_NONE);
+  // scheduler may still have tasks writing to tile buffers
   delete scheduler_;
+  scheduler_ = nullptr;
+  release(GRK_TILE_CACHE_NONE);
   delete mct_;
 }
 uint64_t TileProcessor::getTilePartDataLength(void)
@@ -149,6 +155,48 @@ bool TileProcessor::isCompressor(void)
 {
   return isCompressor_;
 }
+Arena* TileProcessor::getArena(void)
+{
+  return arena_;
+}
+uint64_t TileProcessor::getMemoryFootprint(void) const
+{
+  return memoryFootprint_;
+}
+void TileProcessor::chargeT1Memory(void)
+{
+  // T1 coders are cached per worker thread, so this is an estimate : each worker may hold
+  // a coder sized for the largest code block, with decoded samples and as much coder state
+  uint64_t maxBlockArea = 0;
+  for(uint16_t compno = 0; compno < tile->numcomps_; ++compno)
+  {
+    auto tccp = tcp_->tccps + compno;
+    maxBlockArea = std::max<uint64_t>(maxBlockArea, (uint64_t)1 << (tccp->cblkw + tccp->cblkh));
+  }
+  memTracker_->credit(GRK_MEM_T1, t1Bytes_);
+  t1Bytes_ = ExecSingleton::get().num_workers() * maxBlockArea * 2 * sizeof(int32_t);
+  memTracker_->charge(GRK_MEM_T1, t1Bytes_);
+}
+void TileProcessor::chargeWindowMemory(void)
+{
+  // windows are fully allocated once T1 completes
+  memTracker_->credit(GRK_MEM_TILE_WINDOW, windowBytes_);
+  windowBytes_ = 0;
+  for(uint16_t compno = 0; compno < tile->numcomps_; ++compno)
+    windowBytes_ += (tile->comps + compno)->getAllocatedBytes();
+  memTracker_->charge(GRK_MEM_TILE_WINDOW, windowBytes_);
+  memoryFootprint_ = windowBytes_ + t1Bytes_;
+  // coders are idle again
+  memTracker_->credit(GRK_MEM_T1, t1Bytes_);
+  t1Bytes_ = 0;
+}
+void TileProcessor::creditMemory(void)
+{
+  memTracker_->credit(GRK_MEM_TILE_WINDOW, windowBytes_);
+  windowBytes_ = 0;
+  memTracker_->credit(GRK_MEM_T1, t1Bytes_);
+  t1Bytes_ = 0;
+}
 void TileProcessor::generateImage(GrkImage* src_image, Tile* src_tile)
 {
   if(image_)
@@ -172,6 +220,11 @@ void TileProcessor::release(uint32_t strategy)
   // delete tile components
   delete tile;
   tile = nullptr;
+  creditMemory();
+
+  // all arena objects were destroyed with the tile
+  arenaPool_->release(arena_);
+  arena_ = nullptr;
 }
 PacketTracker* TileProcessor::getPacketTracker(void)
 {
@@ -210,6 +263,8 @@ bool TileProcessor::init(void)
   uint32_t tile_x = tileIndex_ % cp_->t_grid_width;
   uint32_t tile_y = tileIndex_ / cp_->t_grid_width;
   *((grk_rect32*)tile) = cp_->getTileBounds(headerImage, tile_x, tile_y);
+  if(!isCompressor_ && !arena_)
+    arena_ = arenaPool_->acquire();
 
   if(tcp->tccps->numresolutions == 0)
   {
@@ -304,6 +359,7 @@ void TileProcessor::deallocBuffers()
     auto tile_comp = tile->comps + compno;
     tile_comp->dealloc();
   }
+  creditMemory();
 }
 bool TileProcessor::doCompress(void)
 {
@@ -336,7 +392,9 @@ bool TileProcessor::doCompress(void)
       if(!dwt_encode())
         return false;
     }
+    chargeT1Memory();
     t1_encode();
+    chargeWindowMemory();
   }
   // 1. create PLT marker if required
   packetLengthCache.deleteMarkers();
@@ -436,6 +494,8 @@ bool TileProcessor::decompressT2T1(GrkImage* outputImage)
     grklog.error("Decompress: Tile %u has no compressed data", getIndex());
     return false;
   }
+  if(!readDeferredTileParts())
+    return false;
   bool doT1 = !current_plugin_tile || (current_plugin_tile->decompress_flags & GRK_DECODE_T1);
   bool doPostT1 =
       !current_plugin_tile || (current_plugin_tile->decompress_flags & GRK_DECODE_POST_T1);
@@ -456,9 +516,27 @@ bool TileProcessor::decompressT2T1(GrkImage* outputImage)
     }
   }
   bool doT2 = !current_plugin_tile || (current_plugin_tile->decompress_flags & GRK_DECODE_T2);
+  // When the whole tile is decompressed, T1 for a precinct can start as soon as
+  // T2 has parsed its final packet. Tile buffers must then be ready before T2
+  DecompressScheduler* precinctScheduler = nullptr;
+  if(doT2 && doT1 && !current_plugin_tile && cp_->wholeTileDecompress_ &&
+     ExecSingleton::get().num_workers() > 1)
+  {
+    for(uint16_t compno = 0; compno < tile->numcomps_; ++compno)
+    {
+      if(!(tile->comps + compno)->getWindow()->alloc())
+      {
+        grklog.error("Not enough memory for tile data");
+        return false;
+      }
+    }
+    delete scheduler_;
+    precinctScheduler = new DecompressScheduler(this, tile, tcp_, headerImage->comps->prec);
+    scheduler_ = precinctScheduler;
+  }
   if(doT2)
   {
-    auto t2 = std::make_unique<T2Decompress>(this);
+    auto t2 = std::make_unique<T2Decompress>(this, precinctScheduler);
     t2->decompressPackets(tileIndex_, tcp->compressedTileData_, &truncated);
     // synch plugin with T2 data
     // todo re-enable decompress synch
@@ -543,19 +621,40 @@ bool TileProcessor::decompressT2T1(GrkImage* outputImage)
             }
           }
         }
-        ExecSingleton::get().run(taskflow).wait();
+        ExecSingleton::run(taskflow);
         delete[] tasks;
       }
+      // parsers are no longer needed once their packets are read
+      for(uint16_t compno = 0; compno < headerImage->numcomps; ++compno)
+      {
+        auto tilec = tile->comps + compno;
+        for(uint8_t resno = 0; resno < tilec->numResolutionsToDecompress; ++resno)
+          tilec->resolutions_[resno].parserMap_->clear();
+      }
     }
   }
   // T1
   if(doT1)
   {
-    scheduler_ = new DecompressScheduler(this, tile, tcp_, headerImage->comps->prec);
+    chargeT1Memory();
+    if(!precinctScheduler)
+      scheduler_ = new DecompressScheduler(this, tile, tcp_, headerImage->comps->prec);
     FlowComponent* mctPostProc = nullptr;
     // schedule MCT post processing
     if(doPostT1 && needsMctDecompress())
       mctPostProc = scheduler_->getPrePostProc();
+    // inverse DC shift and MCT write samples of the decompress data type straight into
+    // a single tile image, so no 32 bit image is composited and then converted
+    dataTypeWritten_.clear();
+    if(doPostT1 && tcp_->mct != 2 && outputImage->allocTileDataType(tile))
+    {
+      dataTypeWritten_.resize(tile->numcomps_);
+      mct_->setDestination(outputImage);
+    }
+    else
+    {
+      mct_->setDestination(nullptr);
+    }
     uint16_t mctComponentCount = 0;
 
     for(uint16_t compno = 0; compno < tile->numcomps_; ++compno)
@@ -607,6 +706,8 @@ bool TileProcessor::decompressT2T1(GrkImage* outputImage)
               mct_->decompress_dc_shift_rev(dcPostProc, compno);
             else
               mct_->decompress_dc_shift_irrev(dcPostProc, compno);
+            if(!dataTypeWritten_.empty())
+              dataTypeWritten_[compno] = true;
           }
         }
       }
@@ -618,6 +719,7 @@ bool TileProcessor::decompressT2T1(GrkImage* outputImage)
       return false;
     delete scheduler_;
     scheduler_ = nullptr;
+    chargeWindowMemory();
   }
   // 4. post T1
   bool doPost =
@@ -627,7 +729,7 @@ bool TileProcessor::decompressT2T1(GrkImage* outputImage)
     if(outputImage->has_multiple_tiles)
       generateImage(outputImage, tile);
     else
-      outputImage->transferDataFrom(tile);
+      outputImage->transferDataFrom(tile, dataTypeWritten_);
     deallocBuffers();
   }
   if(doT1 && getNumDecompressedPackets() == 0)
@@ -709,6 +811,8 @@ bool TileProcessor::mctDecompress(FlowComponent* flow)
       mct_->decompress_rev(flow);
     else
       mct_->decompress_irrev(flow);
+    if(!dataTypeWritten_.empty())
+      std::fill(dataTypeWritten_.begin(), dataTypeWritten_.begin() + 3, true);
   }
 
   return true;
@@ -1033,6 +1137,24 @@ bool TileProcessor::ingestUncompressedData(uint8_t* p_src, uint64_t src_length)
 
   return true;
 }
+bool TileProcessor::readDeferredTileParts(void)
+{
+  for(auto& tilePart : deferredTileParts_)
+  {
+    auto chunk = tilePart.chunk_;
+    if(stream_->readAt(tilePart.offset_, chunk->buf, chunk->len) != chunk->len)
+    {
+      grklog.error("Tile %u: failed to read %llu bytes of tile part data at offset %llu",
+                   tileIndex_, (unsigned long long)chunk->len,
+                   (unsigned long long)tilePart.offset_);
+      deferredTileParts_.clear();
+      return false;
+    }
+  }
+  deferredTileParts_.clear();
+
+  return true;
+}
 bool TileProcessor::cacheTilePartPackets(CodeStreamDecompress* codeStream)
 {
   assert(codeStream);
@@ -1096,11 +1218,15 @@ bool TileProcessor::cacheTilePartPackets(CodeStreamDecompress* codeStream)
   size_t current_read_size = 0;
   if(tilePartDataLength)
   {
+    // hint this tile part's data, and as many bytes again beyond it : the next tile part
+    // is likely of similar size, so media can fetch it while this tile is decompressed
+    stream_->prefetch(stream_->tell(), 2 * tilePartDataLength);
     if(!tcp->compressedTileData_)
       tcp->compressedTileData_ = new SparseBuffer();
     auto len = tilePartDataLength;
     uint8_t* buff = nullptr;
     auto zeroCopy = stream_->supportsZeroCopy();
+    auto deferRead = !zeroCopy && codeStream->deferTilePartReads();
     if(zeroCopy)
     {
       buff = stream_->getZeroCopyPtr();
@@ -1117,9 +1243,28 @@ bool TileProcessor::cacheTilePartPackets(CodeStreamDecompress* codeStream)
 
         return false;
       }
+      // compressed data is held by the tile coding parameters for the life of the code stream
+      memTracker_->charge(GRK_MEM_COMPRESSED, len);
+    }
+    if(deferRead)
+    {
+      auto offset = stream_->tell();
+      if(!stream_->skip((int64_t)len))
+      {
+        delete[] buff;
+        memTracker_->credit(GRK_MEM_COMPRESSED, len);
+        grklog.error("Stream too short");
+
+        return false;
+      }
+      current_read_size = len;
+      deferredTileParts_.emplace_back(tcp->compressedTileData_->pushBack(buff, len, true), offset);
+    }
+    else
+    {
+      current_read_size = stream_->read(zeroCopy ? nullptr : buff, len);
+      tcp->compressedTileData_->pushBack(buff, len, !zeroCopy);
     }
-    current_read_size = stream_->read(zeroCopy ? nullptr : buff, len);
-    tcp->compressedTileData_->pushBack(buff, len, !zeroCopy);
   }
   if(current_read_size != tilePartDataLength)
     codeStream->getDecompressorState()->setState(DECOMPRESS_STATE_NO_EOC);
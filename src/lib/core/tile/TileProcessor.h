@@ -67,6 +67,17 @@ private:
   uint64_t index(uint32_t comps, uint32_t res, uint64_t prec, uint32_t layer);
 };
 
+/**
+ * Tile part data that is still in the stream, to be read by positional read
+ * into an already allocated chunk of the tile's compressed data
+ */
+struct DeferredTilePart
+{
+  DeferredTilePart(grk_buf8* chunk, uint64_t offset) : chunk_(chunk), offset_(offset) {}
+  grk_buf8* chunk_;
+  uint64_t offset_;
+};
+
 /**
  Tile processor for decompression and compression
  */
@@ -106,6 +117,11 @@ struct TileProcessor
   Tile* getTile(void);
   Scheduler* getScheduler(void);
   bool isCompressor(void);
+  Arena* getArena(void);
+  /**
+   * @brief Gets measured tile window and T1 bytes of the most recently coded tile
+   */
+  uint64_t getMemoryFootprint(void) const;
 
   /** Compression Only
    *  true for first POC tile part, otherwise false*/
@@ -122,6 +138,12 @@ struct TileProcessor
   grk_plugin_tile* current_plugin_tile;
   CodingParams* cp_;
   PLCache packetLengthCache;
+  /** Decompressing only
+   *  if true, T2 records the lengths of parsed packets for the code stream index */
+  bool recordPacketLengths_;
+  /** Decompressing only
+   *  comma coded packet lengths recorded by T2 */
+  std::vector<uint8_t> packetLengths_;
   uint64_t getTilePartDataLength(void);
   bool subtractMarkerSegmentLength(uint16_t markerLen);
   bool setTilePartDataLength(uint16_t tilePart, uint32_t tilePartLength,
@@ -137,6 +159,10 @@ private:
   bool needsMctDecompress(uint16_t compno);
   bool needsMctDecompress(void);
   bool mctDecompress(FlowComponent* flow);
+  bool readDeferredTileParts(void);
+  void chargeT1Memory(void);
+  void chargeWindowMemory(void);
+  void creditMemory(void);
   bool dcLevelShiftCompress();
   bool mct_encode();
   bool dwt_encode();
@@ -155,6 +181,8 @@ private:
   std::atomic<uint64_t> numDecompressedPackets;
   // Decompressing Only
   uint64_t tilePartDataLength;
+  // Decompressing Only
+  std::vector<DeferredTilePart> deferredTileParts_;
   /** index of tile being currently compressed/decompressed */
   uint16_t tileIndex_;
   // Compressing only - track which packets have already been written
@@ -172,6 +200,18 @@ private:
   grk_rect32 unreducedImageWindow;
   uint32_t preCalculatedTileLen;
   mct* mct_;
+  // Decompressing only - components of a single tile image that the final decompress stage
+  // writes in the decompress data type (empty if image is not written in place)
+  std::vector<bool> dataTypeWritten_;
+  // Decompressing only - precincts, code blocks and deferred packet parsers of the tile
+  // are allocated from this arena, which is returned to the pool when the tile is released
+  ArenaPool* arenaPool_;
+  Arena* arena_;
+  MemoryTracker* memTracker_;
+  // bytes currently charged to the memory tracker
+  uint64_t windowBytes_;
+  uint64_t t1Bytes_;
+  uint64_t memoryFootprint_;
 };
 
 } // namespace grk
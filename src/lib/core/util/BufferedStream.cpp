@@ -29,9 +29,12 @@ void grk_read(const uint8_t* buffer, TYPE* value, uint32_t numBytes);
 // buffered stream
 BufferedStream::BufferedStream(uint8_t* buffer, size_t buffer_size, bool is_input)
     : user_data_(nullptr), free_user_data_fn_(nullptr), user_data_length_(0), read_fn_(nullptr),
-      zero_copy_read_fn_(nullptr), write_fn_(nullptr), seek_fn_(nullptr),
+      zero_copy_read_fn_(nullptr), read_at_fn_(nullptr), write_fn_(nullptr), seek_fn_(nullptr),
+      prefetch_fn_(nullptr),
       status_(is_input ? GROK_STREAM_STATUS_INPUT : GROK_STREAM_STATUS_OUTPUT), buf_(nullptr),
-      buffered_bytes_(0), read_bytes_seekable_(0), stream_offset_(0), format_(GRK_CODEC_UNK)
+      buffered_bytes_(0), read_bytes_seekable_(0), stream_offset_(0), read_ahead_(buffer_size),
+      max_read_ahead_(buffer_size), media_seek_(false), filled_(false), prefetch_begin_(0),
+      prefetch_end_(0), format_(GRK_CODEC_UNK)
 {
   buf_ = new grk_buf8((!buffer && buffer_size) ? new uint8_t[buffer_size] : buffer, buffer_size,
                       buffer == nullptr);
@@ -52,6 +55,14 @@ GRK_CODEC_FORMAT BufferedStream::getFormat(void)
 {
   return format_;
 }
+void BufferedStream::setIdentity(const std::string& identity)
+{
+  identity_ = identity;
+}
+const std::string& BufferedStream::getIdentity(void)
+{
+  return identity_;
+}
 void BufferedStream::setUserData(void* data, grk_stream_free_user_data_fn freeUserDataFun)
 {
   user_data_ = data;
@@ -77,6 +88,10 @@ void BufferedStream::setZeroCopyReadFunction(grk_stream_zero_copy_read_fn fn)
 {
   zero_copy_read_fn_ = fn;
 }
+void BufferedStream::setReadAtFunction(grk_stream_read_at_fn fn)
+{
+  read_at_fn_ = fn;
+}
 void BufferedStream::setWriteFunction(grk_stream_write_fn fn)
 {
   write_fn_ = fn;
@@ -85,6 +100,26 @@ void BufferedStream::setSeekFunction(grk_stream_seek_fn fn)
 {
   seek_fn_ = fn;
 }
+void BufferedStream::setPrefetchFunction(grk_stream_prefetch_fn fn)
+{
+  prefetch_fn_ = fn;
+}
+void BufferedStream::setReadAhead(size_t initialLen, size_t maxLen)
+{
+  if(isMemStream())
+    return;
+  max_read_ahead_ = std::clamp<size_t>(maxLen, 1, buf_->len);
+  read_ahead_ = std::clamp<size_t>(initialLen, 1, buf_->len);
+}
+void BufferedStream::adaptReadAhead(bool sequential)
+{
+  if(isMemStream())
+    return;
+  if(sequential)
+    read_ahead_ = std::min(read_ahead_ * 2, max_read_ahead_);
+  else
+    read_ahead_ = std::max(read_ahead_ / 2, std::min(minReadAhead, max_read_ahead_));
+}
 // note: passing in nullptr for buffer will execute a zero-copy read
 size_t BufferedStream::read(uint8_t* buffer, size_t p_size)
 {
@@ -152,11 +187,17 @@ size_t BufferedStream::read(uint8_t* buffer, size_t p_size)
 
   // 5. read from "media"
   invalidate_buffer();
+  if(filled_)
+    adaptReadAhead(!media_seek_);
+  filled_ = true;
+  media_seek_ = false;
   while(true)
   {
-    buffered_bytes_ = read_fn_(buf_->currPtr(), buf_->len, user_data_);
+    // request read-ahead, or the remaining requested bytes if larger
+    size_t fetch = std::min(buf_->len, std::max(read_ahead_, p_size));
+    buffered_bytes_ = read_fn_(buf_->currPtr(), fetch, user_data_);
     // sanity check on external read function
-    if(buffered_bytes_ > buf_->len)
+    if(buffered_bytes_ > fetch)
     {
       grklog.error("Buffered stream: read length greater than buffer length");
       return 0;
@@ -207,6 +248,33 @@ size_t BufferedStream::read(uint8_t* buffer, size_t p_size)
   }
   return 0;
 }
+size_t BufferedStream::readAt(uint64_t offset, uint8_t* buffer, size_t p_size)
+{
+  if(!read_at_fn_ || !buffer || offset >= user_data_length_)
+    return 0;
+  p_size = (size_t)std::min<uint64_t>(p_size, user_data_length_ - offset);
+
+  return read_at_fn_(offset, buffer, p_size, user_data_);
+}
+void BufferedStream::prefetch(uint64_t offset, uint64_t p_size)
+{
+  if(!prefetch_fn_ || !p_size || offset >= user_data_length_)
+    return;
+  uint64_t end = offset + std::min({p_size, maxPrefetch, user_data_length_ - offset});
+  // extend the hinted range forwards; anything else starts a new range
+  if(offset >= prefetch_begin_ && offset <= prefetch_end_)
+  {
+    if(end <= prefetch_end_)
+      return;
+    offset = prefetch_end_;
+  }
+  else
+  {
+    prefetch_begin_ = offset;
+  }
+  prefetch_fn_(offset, end - offset, user_data_);
+  prefetch_end_ = end;
+}
 bool BufferedStream::writeByte(uint8_t value)
 {
   return writeBytes(&value, 1) == 1;
@@ -353,6 +421,10 @@ bool BufferedStream::supportsZeroCopy()
 {
   return isMemStream() && (status_ & GROK_STREAM_STATUS_INPUT);
 }
+bool BufferedStream::supportsReadAt()
+{
+  return read_at_fn_ && (status_ & GROK_STREAM_STATUS_INPUT);
+}
 uint8_t* BufferedStream::getZeroCopyPtr()
 {
   return buf_->currPtr();
@@ -419,6 +491,12 @@ bool BufferedStream::read_seek(uint64_t offset)
   // 2. Since we can't seek in buffer, we must invalidate
   //  buffer contents and seek in media
   invalidate_buffer();
+  if(offset != stream_offset_)
+  {
+    if(media_seek_)
+      adaptReadAhead(false);
+    media_seek_ = true;
+  }
   if(!(seek_fn_(offset, user_data_)))
   {
     status_ |= GROK_STREAM_STATUS_END;
@@ -45,8 +45,18 @@ struct BufferedStream
   uint32_t getStatus(void);
   void setReadFunction(grk_stream_read_fn fn);
   void setZeroCopyReadFunction(grk_stream_zero_copy_read_fn fn);
+  void setReadAtFunction(grk_stream_read_at_fn fn);
   void setWriteFunction(grk_stream_write_fn fn);
   void setSeekFunction(grk_stream_seek_fn fn);
+  void setPrefetchFunction(grk_stream_prefetch_fn fn);
+  /**
+   * Sets read-ahead lengths for a read stream that owns its buffer.
+   * Read-ahead starts at initialLen, so that the main header can be read in one go,
+   * then grows towards maxLen on sequential access and shrinks on media seeks
+   * @param		initialLen	number of bytes requested by the first media read
+   * @param		maxLen		maximum number of bytes requested by subsequent media reads
+   */
+  void setReadAhead(size_t initialLen, size_t maxLen);
   /**
     * Reads some bytes from the stream.
     * @param		buffer	pointer to the data buffer
@@ -57,6 +67,28 @@ struct BufferedStream
     */
   size_t read(uint8_t* buffer, size_t p_size);
 
+  /**
+   * Reads bytes from an absolute offset, bypassing the internal buffer.
+   * Neither uses nor modifies the stream position, so it may be called
+   * concurrently from multiple threads.
+   * @param		offset		absolute stream offset
+   * @param		buffer		pointer to the data buffer that will receive the data
+   * @param		p_size		number of bytes to read
+   *
+   * @return		the number of bytes read
+   */
+  size_t readAt(uint64_t offset, uint8_t* buffer, size_t p_size);
+
+  /**
+   * Hints that a byte range will soon be read, so that the media can fetch it
+   * while the caller is busy decompressing. Does not block, and is a no-op
+   * for streams without a prefetch function. Parts of the range that were
+   * already hinted are skipped.
+   * @param		offset		absolute stream offset
+   * @param		p_size		number of bytes that will be read
+   */
+  void prefetch(uint64_t offset, uint64_t p_size);
+
   // low-level write methods (endian taken into account)
   bool writeShort(uint16_t value);
   bool write24(uint32_t value);
@@ -112,10 +144,17 @@ struct BufferedStream
    */
   bool hasSeek();
   bool supportsZeroCopy();
+  bool supportsReadAt();
   uint8_t* getZeroCopyPtr();
 
   void setFormat(GRK_CODEC_FORMAT format);
   GRK_CODEC_FORMAT getFormat(void);
+  /**
+   * Sets identity of stream source, such as the path, length and modification time
+   * of a file. Streams without an identity, such as memory buffers, have an empty identity
+   */
+  void setIdentity(const std::string& identity);
+  const std::string& getIdentity(void);
 
 private:
   ~BufferedStream();
@@ -154,6 +193,12 @@ private:
   template<typename TYPE>
   bool write(TYPE value, uint8_t numBytes);
   void invalidate_buffer();
+  /**
+   * Adapts read-ahead to access pattern: doubles on sequential media reads,
+   * and halves on media seeks
+   * @param		sequential	true if no media seek occurred since last buffer fill
+   */
+  void adaptReadAhead(bool sequential);
 
   bool isMemStream();
 
@@ -183,6 +228,10 @@ private:
    * Pointer to actual zero copy read function (nullptr at initialization).
    */
   grk_stream_zero_copy_read_fn zero_copy_read_fn_;
+  /**
+   * Pointer to positional read function (nullptr at initialization).
+   */
+  grk_stream_read_at_fn read_at_fn_;
   /**
    * Pointer to actual write function (nullptr at initialization).
    */
@@ -191,6 +240,10 @@ private:
    * Pointer to actual seek function (if available).
    */
   grk_stream_seek_fn seek_fn_;
+  /**
+   * Pointer to prefetch function (nullptr at initialization).
+   */
+  grk_stream_prefetch_fn prefetch_fn_;
   /**
    * Stream status flags
    */
@@ -210,7 +263,24 @@ private:
   // number of bytes read/written from the beginning of the stream
   uint64_t stream_offset_;
 
+  // number of bytes requested from media on next buffer fill
+  size_t read_ahead_;
+  // upper bound on read_ahead_, after the first buffer fill
+  size_t max_read_ahead_;
+  // true if media was seeked since last buffer fill
+  bool media_seek_;
+  // true if buffer has been filled from media at least once
+  bool filled_;
+  // stream range [prefetch_begin_, prefetch_end_) has already been hinted to media
+  uint64_t prefetch_begin_;
+  uint64_t prefetch_end_;
+  // upper bound on a single prefetch hint, to limit page cache pressure
+  static constexpr uint64_t maxPrefetch = 64 * 1024 * 1024;
+  // lower bound on read_ahead_, so that seek-heavy access still reads whole markers
+  static constexpr size_t minReadAhead = 64 * 1024;
+
   GRK_CODEC_FORMAT format_;
+  std::string identity_;
 };
 
 template<typename TYPE>
@@ -2,7 +2,7 @@
 
 namespace grk
 {
-GrkImage::GrkImage()
+GrkImage::GrkImage() : decompressBuffer_{}
 {
   memset((grk_image*)(this), 0, sizeof(grk_image));
   obj.wrapper = new GrkObjectWrapperImpl(this);
@@ -249,6 +249,7 @@ void GrkImage::copyHeader(GrkImage* dest)
   {
     memcpy(&(dest->comps[compno]), &(comps[compno]), sizeof(grk_image_comp));
     dest->comps[compno].data = nullptr;
+    dest->comps[compno].data_type = GRK_INT_32;
   }
 
   dest->color_space = color_space;
@@ -274,6 +275,7 @@ void GrkImage::copyHeader(GrkImage* dest)
   dest->decompress_height = decompress_height;
   dest->decompress_prec = decompress_prec;
   dest->decompress_colour_space = decompress_colour_space;
+  dest->decompress_data_type = decompress_data_type;
   dest->force_rgb = force_rgb;
   dest->upsample = upsample;
   dest->precision = precision;
@@ -287,6 +289,36 @@ bool GrkImage::allocData(grk_image_comp* comp)
   return allocData(comp, false);
 }
 bool GrkImage::allocData(grk_image_comp* comp, bool clear)
+{
+  return allocData(comp, GRK_INT_32, clear);
+}
+size_t GrkImage::dataTypeSize(GRK_DATA_TYPE dataType)
+{
+  switch(dataType)
+  {
+    case GRK_UINT_8:
+      return sizeof(uint8_t);
+    case GRK_UINT_16:
+      return sizeof(uint16_t);
+    case GRK_FLOAT:
+      return sizeof(float);
+    default:
+      return sizeof(int32_t);
+  }
+}
+uint64_t GrkImage::getDataBytes(void) const
+{
+  uint64_t rc = 0;
+  for(uint16_t compno = 0; compno < numcomps; ++compno)
+  {
+    auto comp = comps + compno;
+    if(comp->data)
+      rc += (uint64_t)comp->stride * comp->h * dataTypeSize(comp->data_type);
+  }
+
+  return rc;
+}
+bool GrkImage::allocData(grk_image_comp* comp, GRK_DATA_TYPE dataType, bool clear)
 {
   if(!comp || comp->w == 0 || comp->h == 0)
     return false;
@@ -294,18 +326,17 @@ bool GrkImage::allocData(grk_image_comp* comp, bool clear)
   assert(comp->stride);
   assert(!comp->data);
 
-  size_t dataSize = (uint64_t)comp->stride * comp->h * sizeof(uint32_t);
-  auto data = (int32_t*)grk_aligned_malloc(dataSize);
+  size_t dataSize = (uint64_t)comp->stride * comp->h * dataTypeSize(dataType);
+  auto data = (int32_t*)(clear ? grk_aligned_calloc(dataSize) : grk_aligned_malloc(dataSize));
   if(!data)
   {
     grk::grklog.error("Failed to allocate aligned memory buffer of dimensions %u x %u",
                       comp->stride, comp->h);
     return false;
   }
-  if(clear)
-    memset(data, 0, dataSize);
   single_component_data_free(comp);
   comp->data = data;
+  comp->data_type = dataType;
 
   return true;
 }
@@ -804,13 +835,95 @@ bool GrkImage::apply_palette_clr()
 
   return true;
 }
+int32_t GrkImage::unsignedOffset(const grk_image_comp* comp, GRK_DATA_TYPE dataType)
+{
+  if(!comp->sgnd || comp->prec == 0 || comp->prec > 31 ||
+     (dataType != GRK_UINT_8 && dataType != GRK_UINT_16))
+    return 0;
+
+  return (int32_t)(1U << (comp->prec - 1));
+}
+/**
+ * Convert 32 bit sample to another sample type. Narrow integer samples are offset
+ * (see @ref GrkImage::unsignedOffset) and then clamped to the range of the type
+ */
+template<typename T>
+static T convertSample(int32_t val, int32_t offset)
+{
+  if constexpr(std::is_floating_point_v<T> || std::is_same_v<T, int32_t>)
+    return (T)val;
+  else
+    return (T)std::clamp<int64_t>((int64_t)val + offset, 0, std::numeric_limits<T>::max());
+}
+template<typename T>
+static void convertSamples(const int32_t* src, uint32_t srcStride, T* dest, uint32_t destStride,
+                           int32_t offset, uint32_t w, uint32_t h)
+{
+  for(uint32_t j = 0; j < h; ++j)
+  {
+    for(uint32_t i = 0; i < w; ++i)
+      dest[i] = convertSample<T>(src[i], offset);
+    src += srcStride;
+    dest += destStride;
+  }
+}
+/**
+ * Convert 32 bit samples into a byte addressed buffer, with samples separated by step
+ */
+template<typename T>
+static void writeSamples(const int32_t* src, uint32_t srcStride, uint8_t* dest,
+                         uint64_t destStrideBytes, uint32_t step, int32_t offset, uint32_t w,
+                         uint32_t h)
+{
+  for(uint32_t j = 0; j < h; ++j)
+  {
+    auto destRow = (T*)dest;
+    for(uint32_t i = 0; i < w; ++i)
+      destRow[i * step] = convertSample<T>(src[i], offset);
+    src += srcStride;
+    dest += destStrideBytes;
+  }
+}
+/**
+ * Convert 32 bit samples to a destination buffer of another sample type
+ *
+ * @param src 	      source samples
+ * @param srcStride   source stride
+ * @param dest        destination buffer
+ * @param dataType    destination sample type
+ * @param destIndex   index of first destination sample
+ * @param destStride  destination stride
+ * @param offset      offset added to narrow integer samples (see @ref GrkImage::unsignedOffset)
+ * @param w           width of region to convert
+ * @param h           height of region to convert
+ */
+static void convertSamples(const int32_t* src, uint32_t srcStride, void* dest,
+                           GRK_DATA_TYPE dataType, size_t destIndex, uint32_t destStride,
+                           int32_t offset, uint32_t w, uint32_t h)
+{
+  switch(dataType)
+  {
+    case GRK_UINT_8:
+      convertSamples(src, srcStride, (uint8_t*)dest + destIndex, destStride, offset, w, h);
+      break;
+    case GRK_UINT_16:
+      convertSamples(src, srcStride, (uint16_t*)dest + destIndex, destStride, offset, w, h);
+      break;
+    case GRK_FLOAT:
+      convertSamples(src, srcStride, (float*)dest + destIndex, destStride, offset, w, h);
+      break;
+    default:
+      break;
+  }
+}
 bool GrkImage::allocCompositeData(void)
 {
   // only allocate data if there are multiple tiles. Otherwise, the single tile data
   // will simply be transferred to the output image
-  if(!has_multiple_tiles)
+  if(!has_multiple_tiles || decompressBuffer_.data)
     return true;
 
+  auto dataType = canCompositeDataType(decompress_data_type) ? decompress_data_type : GRK_INT_32;
   for(uint32_t i = 0; i < numcomps; i++)
   {
     auto destComp = comps + i;
@@ -820,9 +933,11 @@ bool GrkImage::allocCompositeData(void)
                    destComp->h);
       return false;
     }
+    if(destComp->data && destComp->data_type != dataType)
+      single_component_data_free(destComp);
     if(!destComp->data)
     {
-      if(!GrkImage::allocData(destComp, true))
+      if(!GrkImage::allocData(destComp, dataType, true))
       {
         grklog.error("Failed to allocate pixel data for component %u, with dimensions %u x %u", i,
                      destComp->w, destComp->h);
@@ -833,6 +948,169 @@ bool GrkImage::allocCompositeData(void)
 
   return true;
 }
+bool GrkImage::allocTileDataType(const Tile* tile)
+{
+  if(has_multiple_tiles || decompress_data_type == GRK_INT_32 || decompressBuffer_.data ||
+     interleaved_data.data || !canCompositeDataType(decompress_data_type))
+    return false;
+  for(uint16_t compno = 0; compno < numcomps; compno++)
+  {
+    auto bounds = tile->comps[compno].getWindow()->bounds();
+    auto comp = comps + compno;
+    if(bounds.width() != comp->w || bounds.height() != comp->h)
+      return false;
+  }
+  for(uint16_t compno = 0; compno < numcomps; compno++)
+  {
+    auto comp = comps + compno;
+    single_component_data_free(comp);
+    if(!allocData(comp, decompress_data_type, false))
+    {
+      grklog.error("Failed to allocate pixel data for component %u, with dimensions %u x %u",
+                   compno, comp->w, comp->h);
+      return false;
+    }
+  }
+
+  return true;
+}
+/**
+ * Check if any post processing stage will modify composite data.
+ * Palette, channel definition, colour management, colour conversion, precision and
+ * upsampling stages all operate on 32 bit planar samples
+ *
+ * @return true if post processing is needed
+ */
+bool GrkImage::needsPostProcess(void)
+{
+  if(meta &&
+     (meta->color.palette || meta->color.channel_definition || meta->color.icc_profile_buf))
+    return true;
+
+  return needsConversionToRGB() || force_rgb || precision || (upsample && isSubsampled());
+}
+/**
+ * Check if tiles can be composited directly into components of given sample type.
+ * If not, then the composite stays 32 bit and is converted after post processing
+ *
+ * @param dataType sample data type
+ *
+ * @return true if tiles can be composited directly
+ */
+bool GrkImage::canCompositeDataType(GRK_DATA_TYPE dataType)
+{
+  return dataType == GRK_INT_32 || !needsPostProcess();
+}
+bool GrkImage::setDecompressBuffer(const grk_decompress_buffer* buffer)
+{
+  decompressBuffer_ = {};
+  if(!buffer)
+    return true;
+  if(needsPostProcess())
+  {
+    grklog.error("Decompress buffer cannot be used for images that need post processing");
+    return false;
+  }
+  if(buffer->interleaved && isSubsampled())
+  {
+    grklog.error("Interleaved decompress buffer cannot be used for subsampled images");
+    return false;
+  }
+  uint64_t sampleSize = dataTypeSize(buffer->data_type);
+  for(uint16_t compno = 0; compno < numcomps; compno++)
+  {
+    auto comp = comps + compno;
+    if(comp->w == 0 || comp->h == 0)
+      continue;
+    uint64_t rowBytes = (uint64_t)comp->w * sampleSize * (buffer->interleaved ? numcomps : 1);
+    uint64_t planeBytes = (uint64_t)(comp->h - 1) * buffer->stride + rowBytes;
+    uint64_t planeOffset = buffer->interleaved ? 0 : compno * buffer->plane_stride;
+    if(buffer->stride < rowBytes || planeOffset + planeBytes > buffer->len)
+    {
+      grklog.error("Decompress buffer of length %" PRIu64 " and stride %" PRIu64
+                   " is too small for component %u, with dimensions %u x %u",
+                   buffer->len, buffer->stride, compno, comp->w, comp->h);
+      return false;
+    }
+    // planes must not overlap
+    if(!buffer->interleaved && compno + 1 < numcomps && buffer->plane_stride < planeBytes)
+    {
+      grklog.error("Decompress buffer plane stride %" PRIu64
+                   " is too small for component %u, with dimensions %u x %u and stride %" PRIu64,
+                   buffer->plane_stride, compno, comp->w, comp->h, buffer->stride);
+      return false;
+    }
+  }
+  decompressBuffer_ = *buffer;
+
+  return true;
+}
+/**
+ * Write window of 32 bit samples into caller owned decompress buffer
+ *
+ * @param compno    component number
+ * @param src 	    source samples
+ * @param srcStride source stride
+ * @param destWin   destination window, relative to component bounds
+ */
+void GrkImage::writeDecompressBuffer(uint16_t compno, const int32_t* src, uint32_t srcStride,
+                                     grk_rect32 destWin)
+{
+  auto buf = &decompressBuffer_;
+  uint64_t sampleSize = dataTypeSize(buf->data_type);
+  uint32_t step = buf->interleaved ? numcomps : 1;
+  auto dest = buf->data + (uint64_t)destWin.y0 * buf->stride +
+              ((uint64_t)destWin.x0 * step + (buf->interleaved ? compno : 0)) * sampleSize;
+  if(!buf->interleaved)
+    dest += compno * buf->plane_stride;
+  auto offset = unsignedOffset(comps + compno, buf->data_type);
+  switch(buf->data_type)
+  {
+    case GRK_UINT_8:
+      writeSamples<uint8_t>(src, srcStride, dest, buf->stride, step, offset, destWin.width(),
+                            destWin.height());
+      break;
+    case GRK_UINT_16:
+      writeSamples<uint16_t>(src, srcStride, dest, buf->stride, step, offset, destWin.width(),
+                             destWin.height());
+      break;
+    case GRK_FLOAT:
+      writeSamples<float>(src, srcStride, dest, buf->stride, step, offset, destWin.width(),
+                          destWin.height());
+      break;
+    default:
+      writeSamples<int32_t>(src, srcStride, dest, buf->stride, step, offset, destWin.width(),
+                            destWin.height());
+      break;
+  }
+}
+bool GrkImage::convertDataType(void)
+{
+  if(interleaved_data.data)
+    return true;
+  for(uint16_t compno = 0; compno < numcomps; compno++)
+  {
+    auto comp = comps + compno;
+    if(!comp->data || comp->data_type != GRK_INT_32 || decompress_data_type == GRK_INT_32)
+      continue;
+    auto dest = *comp;
+    dest.data = nullptr;
+    if(!allocData(&dest, decompress_data_type, false))
+    {
+      grklog.error("Failed to allocate pixel data for component %u, with dimensions %u x %u",
+                   compno, comp->w, comp->h);
+      return false;
+    }
+    convertSamples(comp->data, comp->stride, dest.data, decompress_data_type, 0, dest.stride,
+                   unsignedOffset(comp, decompress_data_type), comp->w, comp->h);
+    single_component_data_free(comp);
+    comp->data = dest.data;
+    comp->stride = dest.stride;
+    comp->data_type = dest.data_type;
+  }
+
+  return true;
+}
 
 /**
  Transfer data to dest for each component, and null out this data.
@@ -850,6 +1128,7 @@ void GrkImage::transferDataTo(GrkImage* dest)
 
     single_component_data_free(destComp);
     destComp->data = srcComp->data;
+    destComp->data_type = srcComp->data_type;
     if(srcComp->stride)
     {
       destComp->stride = srcComp->stride;
@@ -898,15 +1177,45 @@ GrkImage* GrkImage::duplicate(const Tile* src)
 }
 
 void GrkImage::transferDataFrom(const Tile* tile_src_data)
+{
+  transferDataFrom(tile_src_data, std::vector<bool>());
+}
+void GrkImage::transferDataFrom(const Tile* tile_src_data, const std::vector<bool>& written)
 {
   for(uint16_t compno = 0; compno < numcomps; compno++)
   {
     auto srcComp = tile_src_data->comps + compno;
     auto destComp = comps + compno;
+    if(decompressBuffer_.data)
+    {
+      // tile data stays with the tile, and is written to the caller's buffer
+      grk_rect32 destWin;
+      auto srcBuf = srcComp->getWindow()->getResWindowBufferHighestSimple();
+      if(generateCompositeBounds(srcComp->getWindow()->bounds(), compno, &destWin))
+        writeDecompressBuffer(compno, srcBuf.buf_, srcBuf.stride_, destWin);
+      continue;
+    }
+    if(!written.empty())
+    {
+      // component was allocated by allocTileDataType : convert samples that the
+      // final decompress stage has not already written
+      if(written[compno])
+        continue;
+      auto srcBuf = srcComp->getWindow()->getResWindowBufferHighestSimple();
+      if(srcBuf.buf_)
+        convertSamples(srcBuf.buf_, srcBuf.stride_, destComp->data, destComp->data_type, 0,
+                       destComp->stride, unsignedOffset(destComp, destComp->data_type),
+                       destComp->w, destComp->h);
+      else
+        memset(destComp->data, 0,
+               (size_t)destComp->stride * destComp->h * dataTypeSize(destComp->data_type));
+      continue;
+    }
 
     // transfer memory from tile component to output image
     single_component_data_free(destComp);
     srcComp->getWindow()->transfer(&destComp->data, &destComp->stride);
+    destComp->data_type = GRK_INT_32;
     if(destComp->data)
       assert(destComp->stride >= destComp->w);
   }
@@ -914,6 +1223,22 @@ void GrkImage::transferDataFrom(const Tile* tile_src_data)
 
 bool GrkImage::composite(const GrkImage* srcImg)
 {
+  if(decompressBuffer_.data)
+  {
+    for(uint16_t compno = 0; compno < srcImg->numcomps; compno++)
+    {
+      auto srcComp = srcImg->comps + compno;
+      grk_rect32 destWin;
+      if(!srcComp->data || !generateCompositeBounds(srcComp, compno, &destWin))
+      {
+        grklog.warn("GrkImage::composite: unable to write component %u to decompress buffer",
+                    compno);
+        continue;
+      }
+      writeDecompressBuffer(compno, srcComp->data, srcComp->stride, destWin);
+    }
+    return true;
+  }
   return interleaved_data.data ? compositeInterleaved(srcImg) : compositePlanar(srcImg);
 }
 
@@ -1069,8 +1394,15 @@ bool GrkImage::compositePlanar(const GrkImage* src)
       grklog.warn("GrkImage::compositePlanar: null data for source component %u", compno);
       continue;
     }
-    size_t srcIndex = 0;
     auto destIndex = (size_t)destWin.x0 + (size_t)destWin.y0 * destComp->stride;
+    if(destComp->data_type != GRK_INT_32)
+    {
+      convertSamples(srcComp->data, srcComp->stride, destComp->data, destComp->data_type,
+                     destIndex, destComp->stride, unsignedOffset(destComp, destComp->data_type),
+                     destWin.width(), destWin.height());
+      continue;
+    }
+    size_t srcIndex = 0;
     size_t destLineOffset = (size_t)destComp->stride - (size_t)destWin.width();
     auto src_ptr = srcComp->data;
     uint32_t srcLineOffset = srcComp->stride - srcComp->w;
@@ -58,12 +58,65 @@ public:
    * @return 		      true if successful
    */
   static bool allocData(grk_image_comp* imageComp);
+  /**
+   * @brief Allocate data of given sample type for single image component
+   *
+   * @param imageComp         image component
+   * @param dataType          sample data type
+   * @param clear             clear image buffer after allocation
+   *
+   * @return 		      true if successful
+   */
+  static bool allocData(grk_image_comp* imageComp, GRK_DATA_TYPE dataType, bool clear);
+  /**
+   * @brief Get size in bytes of a sample of given data type
+   */
+  static size_t dataTypeSize(GRK_DATA_TYPE dataType);
+  /**
+   * @brief Get offset that maps signed samples of a component into the range of an
+   * unsigned integer type
+   *
+   * @param comp     image component
+   * @param dataType destination sample type
+   * @return 2^(prec-1) for signed components converted to an unsigned integer type, otherwise 0
+   */
+  static int32_t unsignedOffset(const grk_image_comp* comp, GRK_DATA_TYPE dataType);
+  /**
+   * @brief Get number of bytes of component data held by this image
+   */
+  uint64_t getDataBytes(void) const;
   /**
    * Allocate data for tile compositing
    *
    * @return true if successful
    */
   bool allocCompositeData(void);
+  /**
+   * Allocate components of a single tile image in the decompress data type, so that
+   * the final decompress stage of the tile can write its samples straight into them.
+   * Only possible when no post processing stage needs 32 bit samples
+   *
+   * @param tile tile, whose component windows must match the image components
+   *
+   * @return true if components were allocated
+   */
+  bool allocTileDataType(const Tile* tile);
+  /**
+   * Convert 32 bit component data to the decompress data type.
+   * This is the final post processing stage, for images whose post processing
+   * needs 32 bit samples
+   *
+   * @return true if successful
+   */
+  bool convertDataType(void);
+  /**
+   * Set caller owned buffer that tiles are written to, in place of composite data
+   *
+   * @param buffer @ref grk_decompress_buffer, or nullptr to clear
+   *
+   * @return true if buffer can hold this image without post processing
+   */
+  bool setDecompressBuffer(const grk_decompress_buffer* buffer);
 
   /**
    * Copy only header of image and its component header (no data are copied)
@@ -80,6 +133,15 @@ public:
     */
   void transferDataTo(GrkImage* dest);
   void transferDataFrom(const Tile* tile_src_data);
+  /**
+   * Transfer tile data to image. Components allocated by @ref allocTileDataType instead
+   * receive converted samples, unless the final decompress stage has already written them
+   *
+   * @param tile_src_data tile
+   * @param written flags components that the final decompress stage has already written,
+   * or empty if components were not allocated by @ref allocTileDataType
+   */
+  void transferDataFrom(const Tile* tile_src_data, const std::vector<bool>& written);
   GrkImage* duplicate(const Tile* tile_src);
   bool composite(const GrkImage* src);
   bool compositeInterleaved(const GrkImage* src);
@@ -116,6 +178,10 @@ private:
   bool needsConversionToRGB(void);
   bool isOpacity(uint16_t compno);
   bool compositePlanar(const GrkImage* srcImg);
+  bool canCompositeDataType(GRK_DATA_TYPE dataType);
+  bool needsPostProcess(void);
+  void writeDecompressBuffer(uint16_t compno, const int32_t* src, uint32_t srcStride,
+                             grk_rect32 destWin);
   bool generateCompositeBounds(const grk_image_comp* srcComp, uint16_t destCompno,
                                grk_rect32* destWin);
   bool generateCompositeBounds(grk_rect32 src, uint16_t destCompno, grk_rect32* destWin);
@@ -133,6 +199,8 @@ private:
   bool componentsEqual(grk_image_comp* src, grk_image_comp* dest, bool checkPrecision);
   static void copyComponent(grk_image_comp* src, grk_image_comp* dest);
   void scaleComponent(grk_image_comp* component, uint8_t precision);
+
+  grk_decompress_buffer decompressBuffer_;
 };
 
 } // namespace grk
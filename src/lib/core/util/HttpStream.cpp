@@ -0,0 +1,511 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "grk_includes.h"
+
+#ifdef GROK_HAVE_CURL
+#include <curl/curl.h>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#endif
+
+namespace grk
+{
+
+bool is_network_url(const char* fname)
+{
+  if(!fname)
+    return false;
+  return !strncmp(fname, "http://", 7) || !strncmp(fname, "https://", 8);
+}
+
+#ifdef GROK_HAVE_CURL
+
+/**
+ * Response headers of interest
+ */
+struct HttpResponse
+{
+  // code stream length, from Content-Range
+  uint64_t completeLength = 0;
+  std::string etag;
+  std::string lastModified;
+};
+
+/**
+ * Remote code stream accessed with HTTP range requests, with an LRU cache
+ * of fixed size blocks. Positional reads are thread-safe.
+ */
+class HttpStream
+{
+public:
+  explicit HttpStream(const grk_stream_params* params);
+  ~HttpStream();
+  /**
+   * Connects to server and fetches code stream length
+   *
+   * @return true if server supports range requests for this code stream
+   */
+  bool open(void);
+  uint64_t length(void) const;
+  /**
+   * Gets identity of remote code stream : URL, length, and entity tag
+   * or modification time if server reports them
+   */
+  std::string identity(void) const;
+  size_t read(uint8_t* dest, size_t numBytes);
+  size_t readAt(uint64_t offset, uint8_t* dest, size_t numBytes);
+  bool seek(uint64_t offset);
+
+private:
+  struct Block
+  {
+    std::unique_ptr<uint8_t[]> data;
+    size_t len;
+    std::list<uint64_t>::iterator lruPos;
+  };
+  CURL* acquireHandle(void);
+  void releaseHandle(CURL* handle);
+  /**
+   * Requests byte range [offset, offset + len) into dest
+   *
+   * @param written   number of bytes received
+   * @param response  response headers of interest
+   */
+  bool request(uint64_t offset, uint8_t* dest, size_t len, size_t* written,
+               HttpResponse* response);
+  /**
+   * Fetches byte range [offset, offset + len) into dest with a single request
+   */
+  bool fetch(uint64_t offset, uint8_t* dest, size_t len);
+  /**
+   * Caches fetched blocks, starting with block firstBlock, then evicts least recently
+   * used blocks until cache is within capacity
+   */
+  void cacheBlocks(uint64_t firstBlock, const uint8_t* data, size_t len);
+
+  std::string url_;
+  std::string username_;
+  std::string password_;
+  std::string bearerToken_;
+  std::string region_;
+  curl_slist* headers_;
+  uint64_t length_;
+  // entity tag, or modification time, of code stream
+  std::string validator_;
+  // cursor for sequential reads
+  uint64_t offset_;
+
+  std::mutex cacheMutex_;
+  std::unordered_map<uint64_t, Block> blocks_;
+  // most recently used block at front
+  std::list<uint64_t> lru_;
+  uint64_t cachedBytes_;
+
+  std::mutex handleMutex_;
+  std::vector<CURL*> idleHandles_;
+
+public:
+  // default read-ahead of the first buffer fill, which holds the first block
+  static constexpr size_t initialReadAhead = 64 * 1024;
+
+private:
+  static constexpr uint64_t blockSize = 64 * 1024;
+  static constexpr uint64_t cacheCapacity = 64 * 1024 * 1024;
+  // missing runs separated by at most this many cached blocks are fetched in one request,
+  // since re-fetching a few blocks is cheaper than another round trip
+  static constexpr uint64_t maxGapBlocks = 4;
+};
+
+struct HttpSink
+{
+  uint8_t* dest;
+  size_t len;
+  size_t written;
+};
+
+static size_t http_write(char* ptr, size_t size, size_t nmemb, void* user_data)
+{
+  auto sink = (HttpSink*)user_data;
+  size_t numBytes = size * nmemb;
+  // more data than requested means the range was ignored : abort transfer
+  if(numBytes > sink->len - sink->written)
+    return 0;
+  memcpy(sink->dest + sink->written, ptr, numBytes);
+  sink->written += numBytes;
+
+  return numBytes;
+}
+
+// gets value of header if header has this (lower case) name
+static bool http_header_value(const std::string& header, const std::string& name,
+                              std::string* value)
+{
+  if(header.size() <= name.size() ||
+     !std::equal(name.begin(), name.end(), header.begin(),
+                 [](char a, char b) { return a == (char)tolower((unsigned char)b); }))
+    return false;
+  auto begin = header.find_first_not_of(" \t", name.size());
+  auto end = header.find_last_not_of(" \t\r\n");
+  *value = (begin == std::string::npos || end < begin) ? ""
+                                                       : header.substr(begin, end - begin + 1);
+
+  return true;
+}
+
+static size_t http_header(char* buffer, size_t size, size_t nitems, void* user_data)
+{
+  auto response = (HttpResponse*)user_data;
+  size_t numBytes = size * nitems;
+  std::string header(buffer, numBytes);
+  std::string value;
+  if(http_header_value(header, "content-range:", &value))
+  {
+    // Content-Range: bytes <first>-<last>/<complete length>
+    auto slash = value.find('/');
+    if(slash != std::string::npos)
+      response->completeLength = strtoull(value.c_str() + slash + 1, nullptr, 10);
+  }
+  else if(!http_header_value(header, "etag:", &response->etag))
+  {
+    http_header_value(header, "last-modified:", &response->lastModified);
+  }
+
+  return numBytes;
+}
+
+HttpStream::HttpStream(const grk_stream_params* params)
+    : url_(params->file), headers_(nullptr), length_(0), offset_(0), cachedBytes_(0)
+{
+  static std::once_flag curlInit;
+  std::call_once(curlInit, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+  if(params->username)
+    username_ = params->username;
+  if(params->password)
+    password_ = params->password;
+  if(params->bearer_token)
+    bearerToken_ = params->bearer_token;
+  if(params->region)
+    region_ = params->region;
+  // custom header may hold several headers, one per line
+  if(params->custom_header)
+  {
+    std::istringstream iss(params->custom_header);
+    std::string line;
+    while(std::getline(iss, line))
+    {
+      if(!line.empty() && line.back() == '\r')
+        line.pop_back();
+      if(!line.empty())
+        headers_ = curl_slist_append(headers_, line.c_str());
+    }
+  }
+}
+HttpStream::~HttpStream()
+{
+  for(auto handle : idleHandles_)
+    curl_easy_cleanup(handle);
+  curl_slist_free_all(headers_);
+}
+uint64_t HttpStream::length(void) const
+{
+  return length_;
+}
+std::string HttpStream::identity(void) const
+{
+  return url_ + "|" + std::to_string(length_) + "|" + validator_;
+}
+CURL* HttpStream::acquireHandle(void)
+{
+  {
+    std::lock_guard<std::mutex> lock(handleMutex_);
+    if(!idleHandles_.empty())
+    {
+      auto handle = idleHandles_.back();
+      idleHandles_.pop_back();
+      return handle;
+    }
+  }
+  // handles are reused, so that their connections are kept alive between requests
+  auto handle = curl_easy_init();
+  if(!handle)
+    return nullptr;
+  curl_easy_setopt(handle, CURLOPT_URL, url_.c_str());
+  curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, http_write);
+  if(headers_)
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers_);
+  if(!bearerToken_.empty())
+  {
+    curl_easy_setopt(handle, CURLOPT_HTTPAUTH, CURLAUTH_BEARER);
+    curl_easy_setopt(handle, CURLOPT_XOAUTH2_BEARER, bearerToken_.c_str());
+  }
+  else if(!username_.empty())
+  {
+    curl_easy_setopt(handle, CURLOPT_USERNAME, username_.c_str());
+    curl_easy_setopt(handle, CURLOPT_PASSWORD, password_.c_str());
+#if LIBCURL_VERSION_NUM >= 0x074b00
+    // with a region, credentials are an access key and secret for S3 compatible storage
+    if(!region_.empty())
+    {
+      auto sigv4 = "aws:amz:" + region_ + ":s3";
+      curl_easy_setopt(handle, CURLOPT_AWS_SIGV4, sigv4.c_str());
+    }
+#endif
+  }
+
+  return handle;
+}
+void HttpStream::releaseHandle(CURL* handle)
+{
+  std::lock_guard<std::mutex> lock(handleMutex_);
+  idleHandles_.push_back(handle);
+}
+bool HttpStream::request(uint64_t offset, uint8_t* dest, size_t len, size_t* written,
+                         HttpResponse* response)
+{
+  auto handle = acquireHandle();
+  if(!handle)
+  {
+    grklog.error("Unable to create HTTP request for %s", url_.c_str());
+    return false;
+  }
+  HttpSink sink = {dest, len, 0};
+  auto range = std::to_string(offset) + "-" + std::to_string(offset + len - 1);
+  *response = HttpResponse();
+  curl_easy_setopt(handle, CURLOPT_RANGE, range.c_str());
+  curl_easy_setopt(handle, CURLOPT_WRITEDATA, &sink);
+  curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, http_header);
+  curl_easy_setopt(handle, CURLOPT_HEADERDATA, response);
+  auto rc = curl_easy_perform(handle);
+  long responseCode = 0;
+  curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &responseCode);
+  releaseHandle(handle);
+  // a full response would download the whole code stream
+  if(responseCode == 200)
+  {
+    grklog.error("%s: server does not support range requests", url_.c_str());
+    return false;
+  }
+  if(rc != CURLE_OK || responseCode != 206)
+  {
+    grklog.error("%s: request for bytes %s failed (%s, HTTP status %ld)", url_.c_str(),
+                 range.c_str(), curl_easy_strerror(rc), responseCode);
+    return false;
+  }
+  *written = sink.written;
+
+  return true;
+}
+bool HttpStream::fetch(uint64_t offset, uint8_t* dest, size_t len)
+{
+  size_t written = 0;
+  HttpResponse response;
+  if(!request(offset, dest, len, &written, &response))
+    return false;
+  if(written != len)
+  {
+    grklog.error("%s: short response for bytes %" PRIu64 "-%" PRIu64 " (%" PRIu64 " bytes)",
+                 url_.c_str(), offset, offset + len - 1, (uint64_t)written);
+    return false;
+  }
+
+  return true;
+}
+bool HttpStream::open(void)
+{
+  // fetch first block : the 206 response carries the complete length,
+  // and the main header is usually contained in the block
+  std::unique_ptr<uint8_t[]> block(new uint8_t[blockSize]);
+  size_t written = 0;
+  HttpResponse response;
+  if(!request(0, block.get(), blockSize, &written, &response))
+    return false;
+  length_ = response.completeLength;
+  validator_ = !response.etag.empty() ? response.etag : response.lastModified;
+  if(!length_ || written != std::min(blockSize, length_))
+  {
+    grklog.error("Unable to open %s : invalid range response", url_.c_str());
+    return false;
+  }
+  cacheBlocks(0, block.get(), written);
+
+  return true;
+}
+void HttpStream::cacheBlocks(uint64_t firstBlock, const uint8_t* data, size_t len)
+{
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+  for(uint64_t b = firstBlock; len; ++b)
+  {
+    size_t blockLen = (size_t)std::min<uint64_t>(blockSize, len);
+    if(blocks_.find(b) == blocks_.end())
+    {
+      auto& block = blocks_[b];
+      block.data = std::make_unique<uint8_t[]>(blockLen);
+      memcpy(block.data.get(), data, blockLen);
+      block.len = blockLen;
+      lru_.push_front(b);
+      block.lruPos = lru_.begin();
+      cachedBytes_ += blockLen;
+    }
+    data += blockLen;
+    len -= blockLen;
+  }
+  while(cachedBytes_ > cacheCapacity && lru_.size() > 1)
+  {
+    auto victim = blocks_.find(lru_.back());
+    cachedBytes_ -= victim->second.len;
+    blocks_.erase(victim);
+    lru_.pop_back();
+  }
+}
+size_t HttpStream::readAt(uint64_t offset, uint8_t* dest, size_t numBytes)
+{
+  if(!dest || offset >= length_ || !numBytes)
+    return 0;
+  numBytes = (size_t)std::min<uint64_t>(numBytes, length_ - offset);
+  uint64_t end = offset + numBytes;
+  // copy the part of [blockBegin, blockBegin + len) that overlaps the request
+  auto copyOut = [offset, end, dest](uint64_t blockBegin, const uint8_t* src, size_t len) {
+    auto begin = std::max(offset, blockBegin);
+    auto stop = std::min(end, blockBegin + len);
+    if(begin < stop)
+      memcpy(dest + (begin - offset), src + (begin - blockBegin), (size_t)(stop - begin));
+  };
+
+  // 1. copy out cached blocks, and collect runs of missing blocks
+  std::vector<std::pair<uint64_t, uint64_t>> missing;
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    for(uint64_t b = offset / blockSize; b <= (end - 1) / blockSize; ++b)
+    {
+      auto iter = blocks_.find(b);
+      if(iter != blocks_.end())
+      {
+        auto& block = iter->second;
+        lru_.splice(lru_.begin(), lru_, block.lruPos);
+        copyOut(b * blockSize, block.data.get(), block.len);
+      }
+      else if(!missing.empty() && b - missing.back().second <= maxGapBlocks + 1)
+      {
+        missing.back().second = b;
+      }
+      else
+      {
+        missing.emplace_back(b, b);
+      }
+    }
+  }
+  // 2. fetch each run with a single request
+  for(auto& run : missing)
+  {
+    uint64_t rangeBegin = run.first * blockSize;
+    uint64_t rangeEnd = std::min((run.second + 1) * blockSize, length_);
+    size_t rangeLen = (size_t)(rangeEnd - rangeBegin);
+    std::unique_ptr<uint8_t[]> data(new uint8_t[rangeLen]);
+    if(!fetch(rangeBegin, data.get(), rangeLen))
+      return 0;
+    copyOut(rangeBegin, data.get(), rangeLen);
+    cacheBlocks(run.first, data.get(), rangeLen);
+  }
+
+  return numBytes;
+}
+size_t HttpStream::read(uint8_t* dest, size_t numBytes)
+{
+  auto bytesRead = readAt(offset_, dest, numBytes);
+  offset_ += bytesRead;
+
+  return bytesRead;
+}
+bool HttpStream::seek(uint64_t offset)
+{
+  if(offset > length_)
+    return false;
+  offset_ = offset;
+
+  return true;
+}
+
+static size_t read_from_http(uint8_t* buffer, size_t numBytes, void* user_data)
+{
+  return ((HttpStream*)user_data)->read(buffer, numBytes);
+}
+static size_t read_from_http_at(uint64_t offset, uint8_t* buffer, size_t numBytes,
+                                void* user_data)
+{
+  return ((HttpStream*)user_data)->readAt(offset, buffer, numBytes);
+}
+static bool seek_in_http(uint64_t offset, void* user_data)
+{
+  return ((HttpStream*)user_data)->seek(offset);
+}
+static void free_http(void* user_data)
+{
+  auto http = (HttpStream*)user_data;
+  if(http)
+    delete http;
+}
+
+grk_stream* create_http_read_stream(const grk_stream_params* stream_params)
+{
+  if(!stream_params || !stream_params->file)
+    return nullptr;
+  auto http = new HttpStream(stream_params);
+  uint8_t buf[12];
+  GRK_CODEC_FORMAT format;
+  if(!http->open() || http->readAt(0, buf, sizeof(buf)) != sizeof(buf) ||
+     !grk_decompress_buffer_detect_format(buf, sizeof(buf), &format))
+  {
+    delete http;
+    return nullptr;
+  }
+  // each buffer fill of a sequential read is at most one request. Read-ahead starts
+  // small, so that a decompress window near the start of the code stream does not
+  // pull in unrelated tiles : it then grows on sequential access
+  size_t bufferLen = stream_params->double_buffer_len ? stream_params->double_buffer_len : 1000000;
+  size_t initialLen = stream_params->initial_double_buffer_len;
+  if(!initialLen)
+    initialLen = std::min<size_t>(bufferLen, HttpStream::initialReadAhead);
+  auto streamImpl = new BufferedStream(nullptr, std::max(bufferLen, initialLen), true);
+  streamImpl->setReadAhead(initialLen, bufferLen);
+  streamImpl->setFormat(format);
+  streamImpl->setIdentity(http->identity());
+  auto stream = streamImpl->getWrapper();
+  grk_stream_set_user_data(stream, http, free_http);
+  grk_stream_set_user_data_length(stream, http->length());
+  grk_stream_set_read_function(stream, read_from_http);
+  grk_stream_set_read_at_function(stream, read_from_http_at);
+  grk_stream_set_seek_function(stream, seek_in_http);
+
+  return stream;
+}
+
+#else
+
+grk_stream* create_http_read_stream(const grk_stream_params* stream_params)
+{
+  grklog.error("Unable to open %s : library was built without network support",
+               stream_params && stream_params->file ? stream_params->file : "");
+  return nullptr;
+}
+
+#endif
+
+} // namespace grk
@@ -0,0 +1,48 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+namespace grk
+{
+
+/**
+ * Check if a file name is an http or https URL
+ *
+ * @param fname   file name
+ *
+ * @return true if file name is a URL
+ */
+bool is_network_url(const char* fname);
+
+/** Create read stream from a remote code stream, using HTTP range requests
+ *
+ * Only the byte ranges that are actually read are fetched : tile parts that
+ * are skipped because they lie outside the decompress window are never downloaded.
+ * Missing cache blocks that are adjacent, or separated by a small gap, are
+ * coalesced into a single request, and fetched blocks are kept in an LRU cache.
+ * The stream supports positional reads, so tile part data for concurrently
+ * decompressed tiles is fetched by the workers.
+ *
+ * @param stream_params   stream parameters : file holds the URL, and the
+ *                        authorization fields are passed on to the server
+ *
+ * @return stream, or nullptr if the code stream could not be reached,
+ * or the library was built without network support
+ */
+grk_stream* create_http_read_stream(const grk_stream_params* stream_params);
+
+} // namespace grk
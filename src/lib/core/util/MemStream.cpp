@@ -14,18 +14,43 @@
  *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *
  */
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "grk_includes.h"
 
 namespace grk
 {
+#ifdef _WIN32
+static const grk_handle invalidHandle = INVALID_HANDLE_VALUE;
+#else
+static const grk_handle invalidHandle = -1;
+#endif
+
+static void unmap(uint8_t* buf, size_t len);
+static void close_handle(grk_handle fd);
+
 MemStream::MemStream(uint8_t* buffer, size_t offset, size_t length, bool owns)
-    : buf(buffer), off(offset), len(length), fd(0), ownsBuffer(owns)
+    : buf(buffer), off(offset), len(length), fd(invalidHandle), ownsBuffer(owns)
 {}
 MemStream::MemStream() : MemStream(nullptr, 0, 0, false) {}
 MemStream::~MemStream()
 {
-  if(ownsBuffer)
+  if(fd != invalidHandle)
+  {
+    unmap(buf, len);
+    close_handle(fd);
+  }
+  else if(ownsBuffer)
+  {
     delete[] buf;
+  }
 }
 
 static void free_mem(void* user_data)
@@ -76,6 +101,17 @@ static size_t read_from_mem(uint8_t* dest, size_t numBytes, void* src)
   return nb_read;
 }
 
+static size_t read_from_mem_at(uint64_t offset, uint8_t* dest, size_t numBytes, void* src)
+{
+  auto srcStream = (MemStream*)src;
+  if(!dest || offset >= srcStream->len)
+    return 0;
+  auto nb_read = (size_t)std::min<uint64_t>(numBytes, srcStream->len - offset);
+  memcpy(dest, srcStream->buf + offset, nb_read);
+
+  return nb_read;
+}
+
 static size_t write_to_mem(const uint8_t* src, size_t numBytes, void* dest)
 {
   auto destStream = (MemStream*)dest;
@@ -126,6 +162,7 @@ void set_up_mem_stream(grk_stream* stream, size_t len, bool is_read_stream)
   {
     grk_stream_set_read_function(stream, read_from_mem);
     grk_stream_set_zero_copy_read_function(stream, zero_copy_read_from_mem);
+    grk_stream_set_read_at_function(stream, read_from_mem_at);
   }
   else
     grk_stream_set_write_function(stream, write_to_mem);
@@ -168,4 +205,120 @@ grk_stream* create_mem_stream(uint8_t* buf, size_t len, bool ownsBuffer, bool is
   return (grk_stream*)stream;
 }
 
+#ifdef _WIN32
+static grk_handle open_handle(const char* fname)
+{
+  return CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                     FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+}
+static void close_handle(grk_handle fd)
+{
+  CloseHandle(fd);
+}
+static uint64_t handle_size(grk_handle fd)
+{
+  LARGE_INTEGER size;
+  if(!GetFileSizeEx(fd, &size))
+    return 0;
+  return (uint64_t)size.QuadPart;
+}
+static uint8_t* map(grk_handle fd, size_t len)
+{
+  auto mapping = CreateFileMappingA(fd, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if(!mapping)
+    return nullptr;
+  auto ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, len);
+  // view keeps the mapping object alive
+  CloseHandle(mapping);
+
+  return (uint8_t*)ptr;
+}
+static void unmap(uint8_t* buf, [[maybe_unused]] size_t len)
+{
+  if(buf)
+    UnmapViewOfFile(buf);
+}
+#else
+static grk_handle open_handle(const char* fname)
+{
+  return open(fname, O_RDONLY);
+}
+static void close_handle(grk_handle fd)
+{
+  close(fd);
+}
+static uint64_t handle_size(grk_handle fd)
+{
+  struct stat st;
+  if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    return 0;
+  return (uint64_t)st.st_size;
+}
+static uint8_t* map(grk_handle fd, size_t len)
+{
+  auto ptr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+  if(ptr == MAP_FAILED)
+    return nullptr;
+
+  return (uint8_t*)ptr;
+}
+static void unmap(uint8_t* buf, size_t len)
+{
+  if(buf)
+    munmap(buf, len);
+}
+#ifdef MADV_WILLNEED
+static void prefetch_from_map(uint64_t offset, uint64_t numBytes, void* src)
+{
+  auto srcStream = (MemStream*)src;
+  // mapping is page aligned, so the range only needs to be aligned relative to it
+  auto pageMask = (uint64_t)sysconf(_SC_PAGESIZE) - 1;
+  auto begin = offset & ~pageMask;
+  madvise(srcStream->buf + begin, (size_t)(offset + numBytes - begin), MADV_WILLNEED);
+}
+#endif
+#endif
+
+grk_stream* create_mapped_file_read_stream(const char* fname)
+{
+  if(!fname || !fname[0])
+    return nullptr;
+  auto fd = open_handle(fname);
+  if(fd == invalidHandle)
+    return nullptr;
+  auto len = handle_size(fd);
+  if(len < 12 || len > (uint64_t)SIZE_MAX)
+  {
+    close_handle(fd);
+    return nullptr;
+  }
+  auto buf = map(fd, (size_t)len);
+  if(!buf)
+  {
+    close_handle(fd);
+    return nullptr;
+  }
+  GRK_CODEC_FORMAT format;
+  if(!grk_decompress_buffer_detect_format(buf, (size_t)len, &format))
+  {
+    unmap(buf, (size_t)len);
+    close_handle(fd);
+    return nullptr;
+  }
+  // stream does not own the mapping: MemStream unmaps it when the stream is destroyed
+  auto memStream = new MemStream(buf, 0, (size_t)len, false);
+  memStream->fd = fd;
+  auto streamImpl = new BufferedStream(buf, (size_t)len, true);
+  streamImpl->setFormat(format);
+  auto stream = streamImpl->getWrapper();
+  grk_stream_set_user_data((grk_stream*)stream, memStream, free_mem);
+  set_up_mem_stream((grk_stream*)stream, memStream->len, true);
+#if !defined(_WIN32) && defined(MADV_WILLNEED)
+  // page faults on zero-copy tile data would otherwise stall decompression on cold reads
+  grk_stream_set_prefetch_function((grk_stream*)stream, prefetch_from_map);
+#endif
+
+  return (grk_stream*)stream;
+}
+
 } // namespace grk
@@ -55,4 +55,15 @@ grk_stream* create_mem_stream(uint8_t* buf, size_t len, bool ownsBuffer, bool is
 
 size_t get_mem_stream_offset(grk_stream* stream);
 
+/** Create read stream from memory-mapped file
+ *
+ * The entire file is mapped read-only, and the stream supports zero-copy reads,
+ * so tile part data is referenced directly from the mapping rather than copied.
+ *
+ * @param fname   file name
+ *
+ * @return stream, or nullptr if the file could not be mapped
+ */
+grk_stream* create_mapped_file_read_stream(const char* fname);
+
 } // namespace grk
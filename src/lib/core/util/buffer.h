@@ -26,7 +26,7 @@ struct AllocatorVanilla
   {
     return new T[length];
   }
-  void dealloc(T* buf)
+  void dealloc(T* buf, [[maybe_unused]] size_t length)
   {
     delete[] buf;
   }
@@ -38,11 +38,27 @@ struct AllocatorAligned
   {
     return (T*)grk_aligned_malloc(length * sizeof(T));
   }
-  void dealloc(T* buf)
+  void dealloc(T* buf, [[maybe_unused]] size_t length)
   {
     grk_aligned_free(buf);
   }
 };
+/**
+ * Aligned allocator that recycles buffers through the process wide BufferPool.
+ * Buffers transferred out of a grk_buf may still be freed with grk_aligned_free
+ */
+template<typename T>
+struct AllocatorPooled
+{
+  T* alloc(size_t length)
+  {
+    return (T*)BufferPool::get().acquire(length * sizeof(T));
+  }
+  void dealloc(T* buf, size_t length)
+  {
+    BufferPool::get().release(buf, length * sizeof(T));
+  }
+};
 template<typename T, template<typename TT> typename A>
 struct grk_buf : A<T>
 {
@@ -117,12 +133,17 @@ struct grk_buf : A<T>
   virtual void dealloc()
   {
     if(owns_data)
-      A<T>::dealloc(buf);
+      A<T>::dealloc(buf, len);
     buf = nullptr;
     owns_data = false;
     offset = 0;
     len = 0;
   }
+  // number of bytes allocated and owned by this buffer
+  size_t allocatedBytes(void) const
+  {
+    return owns_data ? len * sizeof(T) : 0;
+  }
   // set buf to buf without owning it
   void attach(T* buffer)
   {
@@ -331,6 +352,10 @@ struct grk_buf2d : protected grk_buf<T, A>, public grk_rect32
       *strd = stride;
     }
   }
+  size_t allocatedBytes(void) const
+  {
+    return grk_buf<T, A>::allocatedBytes();
+  }
 
   /** Returns whether window bounds are valid (non empty and within buffer bounds)
    *
@@ -489,7 +489,7 @@ bool WaveletFwdImpl::encode_procedure(TileComponent* tilec)
       }
       if(node)
       {
-        ExecSingleton::get().run(taskflow).wait();
+        ExecSingleton::run(taskflow);
         delete[] node;
       }
       if(!rc)
@@ -555,7 +555,7 @@ bool WaveletFwdImpl::encode_procedure(TileComponent* tilec)
       }
       if(node)
       {
-        ExecSingleton::get().run(taskflow).wait();
+        ExecSingleton::run(taskflow);
         delete[] node;
       }
       if(!rc)
@@ -506,10 +506,10 @@ void WaveletReverse::decompress_h_strip_97(dwt_data<vec4f>* GRK_RESTRICT horiz,
     }
   }
 }
-bool WaveletReverse::decompress_h_97(uint8_t res, uint32_t num_workers, size_t dataLength,
-                                     dwt_data<vec4f>& GRK_RESTRICT horiz, const uint32_t resHeight,
-                                     grk_buf2d_simple<float> winL, grk_buf2d_simple<float> winH,
-                                     grk_buf2d_simple<float> winDest)
+bool WaveletReverse::decompress_h_97(uint8_t res, eSplitOrientation split, uint32_t num_workers,
+                                     size_t dataLength, dwt_data<vec4f>& GRK_RESTRICT horiz,
+                                     const uint32_t resHeight, grk_buf2d_simple<float> winL,
+                                     grk_buf2d_simple<float> winH, grk_buf2d_simple<float> winDest)
 {
   if(resHeight == 0)
     return true;
@@ -530,6 +530,37 @@ bool WaveletReverse::decompress_h_97(uint8_t res, uint32_t num_workers, size_t d
       return true;
     }
     auto resFlow = imageComponentFlow->getResFlow(res - 1);
+    if(resFlow->stripsEnabled())
+    {
+      // strips are run by the code blocks they depend on, so scratch memory
+      // is only allocated while a strip is in flight
+      auto& strips = resFlow->strips_[split];
+      for(uint32_t i = 0; i < strips.size(); ++i)
+      {
+        auto rows = strips.getRows(i);
+        if(rows.x0 >= resHeight)
+          break;
+        uint32_t height = std::min(rows.x1, resHeight) - rows.x0;
+        auto stripL = winL;
+        auto stripH = winH;
+        auto stripDest = winDest;
+        stripL.incY_IN_PLACE(rows.x0);
+        stripH.incY_IN_PLACE(rows.x0);
+        stripDest.incY_IN_PLACE(rows.x0);
+        strips.setStrip(i, [this, horiz, dataLength, height, stripL, stripH,
+                            stripDest]() mutable {
+          if(!horiz.alloc(dataLength))
+          {
+            grklog.error("Out of memory");
+            scheduler_->setFailed();
+            return;
+          }
+          decompress_h_strip_97(&horiz, height, stripL, stripH, stripDest);
+          horiz.release();
+        });
+      }
+      return true;
+    }
     for(uint32_t j = 0; j < numTasks; ++j)
     {
       auto indexMin = j * incrPerJob;
@@ -689,11 +720,12 @@ bool WaveletReverse::decompress_tile_97(void)
     horizF_.win_h = grk_line32(0, horizF_.dn_full);
     auto winSplitL = buf->getResWindowBufferSplitSimpleF(res, SPLIT_L);
     auto winSplitH = buf->getResWindowBufferSplitSimpleF(res, SPLIT_H);
-    if(!decompress_h_97(res, num_workers, dataLength, horizF_, vertF_.sn_full,
+    if(!decompress_h_97(res, SPLIT_L, num_workers, dataLength, horizF_, vertF_.sn_full,
                         buf->getResWindowBufferSimpleF(res - 1U),
                         buf->getBandWindowBufferPaddedSimpleF(res, BAND_ORIENT_HL), winSplitL))
       return false;
-    if(!decompress_h_97(res, num_workers, dataLength, horizF_, resHeight - vertF_.sn_full,
+    if(!decompress_h_97(res, SPLIT_H, num_workers, dataLength, horizF_,
+                        resHeight - vertF_.sn_full,
                         buf->getBandWindowBufferPaddedSimpleF(res, BAND_ORIENT_LH),
                         buf->getBandWindowBufferPaddedSimpleF(res, BAND_ORIENT_HH), winSplitH))
       return false;
@@ -1067,6 +1099,36 @@ bool WaveletReverse::decompress_h_53(uint8_t res, TileComponentWindow<int32_t>*
       }
       decompress_h_strip_53(&horiz_, 0, height[orient], winL, winH, winDest);
     }
+    else if(resFlow->stripsEnabled())
+    {
+      // strips are run by the code blocks they depend on, so scratch memory
+      // is only allocated while a strip is in flight
+      auto& strips = resFlow->strips_[orient];
+      for(uint32_t i = 0; i < strips.size(); ++i)
+      {
+        auto rows = strips.getRows(i);
+        if(rows.x0 >= height[orient])
+          break;
+        uint32_t hMax = std::min(rows.x1, height[orient]);
+        auto stripL = winL;
+        auto stripH = winH;
+        auto stripDest = winDest;
+        stripL.incY_IN_PLACE(rows.x0);
+        stripH.incY_IN_PLACE(rows.x0);
+        stripDest.incY_IN_PLACE(rows.x0);
+        strips.setStrip(i, [this, horiz = dwt_data<int32_t>(horiz_), dataLength, rows, hMax,
+                            stripL, stripH, stripDest]() mutable {
+          if(!horiz.alloc(dataLength))
+          {
+            grklog.error("Out of memory");
+            scheduler_->setFailed();
+            return;
+          }
+          decompress_h_strip_53(&horiz, rows.x0, hMax, stripL, stripH, stripDest);
+          horiz.release();
+        });
+      }
+    }
     else
     {
       uint32_t incrPerJob = height[orient] / numTasks[orient];
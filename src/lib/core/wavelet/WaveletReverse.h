@@ -159,8 +159,9 @@ private:
   void decompress_h_strip_97(dwt_data<vec4f>* GRK_RESTRICT horiz, const uint32_t resHeight,
                              grk_buf2d_simple<float> winL, grk_buf2d_simple<float> winH,
                              grk_buf2d_simple<float> winDest);
-  bool decompress_h_97(uint8_t res, uint32_t num_workers, size_t dataLength,
-                       dwt_data<vec4f>& GRK_RESTRICT horiz, const uint32_t resHeight,
+  bool decompress_h_97(uint8_t res, eSplitOrientation split, uint32_t num_workers,
+                       size_t dataLength, dwt_data<vec4f>& GRK_RESTRICT horiz,
+                       const uint32_t resHeight,
                        grk_buf2d_simple<float> winL, grk_buf2d_simple<float> winH,
                        grk_buf2d_simple<float> winDest);
   void interleave_v_97(dwt_data<vec4f>* GRK_RESTRICT dwt, grk_buf2d_simple<float> winL,
@@ -0,0 +1,127 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "grok.h"
+#include "GrkTestCodeStream.h"
+#include "GrkAsyncSwathTest.h"
+
+namespace grk
+{
+
+/**
+ * Creates decompressor for file, and reads header
+ */
+static grk_object* createDecompressor(const char* path, grk_decompress_parameters* params)
+{
+  grk_stream_params streamParams = {};
+  streamParams.file = path;
+  auto codec = grk_decompress_init(&streamParams, params);
+  if(!check(codec != nullptr, "create decompressor"))
+    return nullptr;
+  grk_header_info headerInfo = {};
+  if(!check(grk_decompress_read_header(codec, &headerInfo), "read header"))
+  {
+    grk_object_unref(codec);
+    return nullptr;
+  }
+
+  return codec;
+}
+
+/**
+ * Checks that rows [y0,y1) of image match reference image
+ */
+static bool checkSwath(const grk_image* image, const grk_image* ref, uint32_t y0, uint32_t y1)
+{
+  for(uint16_t compno = 0; compno < image->numcomps; ++compno)
+  {
+    auto comp = image->comps + compno;
+    auto refComp = ref->comps + compno;
+    auto data = (const int32_t*)comp->data;
+    auto refData = (const int32_t*)refComp->data;
+    if(!data || !refData || comp->w != refComp->w || comp->h != refComp->h)
+      return false;
+    for(uint32_t y = y0 - image->y0; y < y1 - image->y0; ++y)
+      for(uint32_t x = 0; x < comp->w; ++x)
+        if(data[(size_t)y * comp->stride + x] != refData[(size_t)y * refComp->stride + x])
+          return false;
+  }
+
+  return true;
+}
+
+static bool runTest(void)
+{
+  auto file = testFilePath("grk_async_swath_test.j2k");
+  TestImageParams imageParams;
+  if(!check(compressTestImage(file.c_str(), imageParams), "compress test image"))
+    return false;
+
+  grk_decompress_parameters syncParams = {};
+  auto syncCodec = createDecompressor(file.c_str(), &syncParams);
+  bool rc = syncCodec && check(grk_decompress(syncCodec, nullptr), "decompress synchronously");
+  grk_decompress_parameters asyncParams = {};
+  asyncParams.asynchronous = true;
+  auto asyncCodec = rc ? createDecompressor(file.c_str(), &asyncParams) : nullptr;
+  rc = asyncCodec && check(grk_decompress(asyncCodec, nullptr), "decompress asynchronously");
+
+  // swaths straddle tile rows, so some tiles are waited on by two swaths
+  if(rc)
+  {
+    auto ref = grk_decompress_get_image(syncCodec);
+    auto image = grk_decompress_get_image(asyncCodec);
+    const uint32_t swathHeight = imageParams.tileDim * 3 / 4;
+    for(uint32_t y0 = image->y0; rc && y0 < image->y1; y0 += swathHeight)
+    {
+      grk_wait_swath swath = {};
+      swath.x0 = image->x0;
+      swath.y0 = y0;
+      swath.x1 = image->x1;
+      swath.y1 = std::min(y0 + swathHeight, image->y1);
+      grk_decompress_wait(asyncCodec, &swath);
+      uint32_t tileY1 = (swath.y1 + imageParams.tileDim - 1) / imageParams.tileDim;
+      rc = check(swath.tile_x0 == 0 && swath.tile_x1 == swath.num_tile_cols &&
+                     swath.tile_y0 == y0 / imageParams.tileDim && swath.tile_y1 == tileY1,
+                 "swath tile bounds") &&
+           check(checkSwath(image, ref, swath.y0, swath.y1), "swath samples");
+    }
+    grk_decompress_wait(asyncCodec, nullptr);
+    rc = rc && check(imageChecksum(image) == imageChecksum(ref), "asynchronous image");
+  }
+  if(asyncCodec)
+    grk_object_unref(asyncCodec);
+  if(syncCodec)
+    grk_object_unref(syncCodec);
+  remove(file.c_str());
+
+  return rc;
+}
+
+int GrkAsyncSwathTest::main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+{
+  grk_initialize(nullptr, 0);
+  bool rc = runTest();
+  grk_deinitialize();
+
+  return rc ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace grk
@@ -0,0 +1,230 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <thread>
+
+#include "grok.h"
+#include "grk_config.h"
+#include "GrkBenchCodec.h"
+
+namespace grk
+{
+
+struct BenchParams
+{
+  uint32_t width = 64;
+  uint32_t height = 64;
+  uint16_t numcomps = 3;
+  uint32_t tileSize = 0;
+  uint32_t iterations = 1000;
+  uint32_t numThreads = 0;
+  bool irreversible = false;
+};
+
+static void usage(const char* app)
+{
+  fprintf(stderr,
+          "Usage: %s [-w width] [-h height] [-c components] [-t tile size (0 = single tile)]\n"
+          "          [-n iterations] [-H threads (0 = all cores)] [-I irreversible (0 or 1)]\n",
+          app);
+}
+
+static grk_image* createImage(const BenchParams& bp)
+{
+  auto comps = std::make_unique<grk_image_comp[]>(bp.numcomps);
+  memset(comps.get(), 0, sizeof(grk_image_comp) * bp.numcomps);
+  for(uint16_t compno = 0; compno < bp.numcomps; ++compno)
+  {
+    auto comp = comps.get() + compno;
+    comp->w = bp.width;
+    comp->h = bp.height;
+    comp->dx = 1;
+    comp->dy = 1;
+    comp->prec = 8;
+  }
+  auto image = grk_image_new(bp.numcomps, comps.get(),
+                             bp.numcomps == 3 ? GRK_CLRSPC_SRGB : GRK_CLRSPC_GRAY, true);
+  if(!image)
+    return nullptr;
+  for(uint16_t compno = 0; compno < bp.numcomps; ++compno)
+  {
+    auto comp = image->comps + compno;
+    auto data = (int32_t*)comp->data;
+    for(uint32_t j = 0; j < comp->h; ++j)
+    {
+      for(uint32_t i = 0; i < comp->w; ++i)
+        data[(size_t)j * comp->stride + i] =
+            (int32_t)(((i * 7 + j * 3 + compno * 50u) ^ (i * j)) & 0xFF);
+    }
+  }
+
+  return image;
+}
+
+static uint64_t compress(const BenchParams& bp, grk_image* image, uint8_t* buf, size_t len)
+{
+  grk_cparameters parameters;
+  grk_compress_set_default_params(&parameters);
+  parameters.cod_format = GRK_FMT_J2K;
+  parameters.irreversible = bp.irreversible;
+  if(bp.tileSize)
+  {
+    parameters.tile_size_on = true;
+    parameters.t_width = bp.tileSize;
+    parameters.t_height = bp.tileSize;
+  }
+  grk_stream_params streamParams = {};
+  streamParams.buf = buf;
+  streamParams.buf_len = len;
+  auto codec = grk_compress_init(&streamParams, &parameters, image);
+  if(!codec)
+    return 0;
+  uint64_t compressedLength = grk_compress(codec, nullptr);
+  grk_object_unref(codec);
+
+  return compressedLength;
+}
+
+static bool decompress(uint8_t* buf, size_t len)
+{
+  grk_decompress_parameters parameters = {};
+  grk_stream_params streamParams = {};
+  streamParams.buf = buf;
+  streamParams.buf_len = len;
+  auto codec = grk_decompress_init(&streamParams, &parameters);
+  if(!codec)
+    return false;
+  grk_header_info headerInfo = {};
+  bool rc = grk_decompress_read_header(codec, &headerInfo) && grk_decompress(codec, nullptr);
+  grk_object_unref(codec);
+
+  return rc;
+}
+
+int GrkBenchCodec::main(int argc, char** argv)
+{
+  BenchParams bp;
+  for(int i = 1; i < argc; i += 2)
+  {
+    if(i + 1 >= argc || argv[i][0] != '-' || strlen(argv[i]) != 2)
+    {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    auto val = (uint32_t)strtoul(argv[i + 1], nullptr, 10);
+    switch(argv[i][1])
+    {
+      case 'w':
+        bp.width = val;
+        break;
+      case 'h':
+        bp.height = val;
+        break;
+      case 'c':
+        bp.numcomps = (uint16_t)val;
+        break;
+      case 't':
+        bp.tileSize = val;
+        break;
+      case 'n':
+        bp.iterations = val;
+        break;
+      case 'H':
+        bp.numThreads = val;
+        break;
+      case 'I':
+        bp.irreversible = val != 0;
+        break;
+      default:
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if(!bp.width || !bp.height || !bp.numcomps || !bp.iterations)
+  {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  int32_t rc = EXIT_FAILURE;
+  grk_initialize(nullptr, bp.numThreads);
+
+  size_t bufLen = (size_t)bp.width * bp.height * bp.numcomps * 2 + (1 << 16);
+  auto buf = std::make_unique<uint8_t[]>(bufLen);
+  uint64_t compressedLength = 0;
+  std::chrono::duration<double, std::milli> compressTime(0), decompressTime(0);
+  // process CPU time, summed over all threads
+  std::clock_t decompressCpu = 0;
+  for(uint32_t i = 0; i < bp.iterations; ++i)
+  {
+    // compression modifies image samples in place, so each iteration gets a fresh image
+    auto image = createImage(bp);
+    if(!image)
+    {
+      fprintf(stderr, "Failed to create image\n");
+      goto cleanup;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    compressedLength = compress(bp, image, buf.get(), bufLen);
+    compressTime += std::chrono::high_resolution_clock::now() - start;
+    grk_object_unref(&image->obj);
+    if(!compressedLength)
+    {
+      fprintf(stderr, "Failed to compress image\n");
+      goto cleanup;
+    }
+  }
+  for(uint32_t i = 0; i < bp.iterations; ++i)
+  {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto startCpu = std::clock();
+    bool success = decompress(buf.get(), (size_t)compressedLength);
+    decompressCpu += std::clock() - startCpu;
+    decompressTime += std::chrono::high_resolution_clock::now() - start;
+    if(!success)
+    {
+      fprintf(stderr, "Failed to decompress image\n");
+      goto cleanup;
+    }
+  }
+  fprintf(stdout, "%u x %u x %u image, tile size %u, %u iterations, %llu compressed bytes\n",
+          bp.width, bp.height, bp.numcomps, bp.tileSize, bp.iterations,
+          (unsigned long long)compressedLength);
+  fprintf(stdout, "compress   : %.4f ms per image\n", compressTime.count() / bp.iterations);
+  fprintf(stdout, "decompress : %.4f ms per image\n", decompressTime.count() / bp.iterations);
+  {
+    // fraction of available cores kept busy during decompression
+    uint32_t numThreads = bp.numThreads ? bp.numThreads : std::thread::hardware_concurrency();
+    double cpuMs = 1000.0 * (double)decompressCpu / CLOCKS_PER_SEC;
+    if(numThreads && decompressTime.count() > 0)
+      fprintf(stdout, "decompress : %.1f%% core utilisation over %u threads\n",
+              100.0 * cpuMs / (decompressTime.count() * numThreads), numThreads);
+  }
+  rc = EXIT_SUCCESS;
+
+cleanup:
+  grk_deinitialize();
+
+  return rc;
+}
+
+} // namespace grk
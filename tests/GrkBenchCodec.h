@@ -0,0 +1,33 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+namespace grk
+{
+
+/**
+ * @class GrkBenchCodec
+ * @brief Measures per-image compress and decompress latency on a synthetic
+ * in-memory image, so that fixed per-image overhead (thread creation,
+ * scheduling set up) can be compared across builds
+ */
+class GrkBenchCodec
+{
+public:
+  int main(int argc, char** argv);
+};
+
+} // namespace grk
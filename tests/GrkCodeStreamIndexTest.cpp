@@ -0,0 +1,193 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "grok.h"
+#include "GrkTestCodeStream.h"
+#include "GrkCodeStreamIndexTest.h"
+
+namespace grk
+{
+
+static const double testWindow[4] = {100, 100, 300, 260};
+
+static uint32_t readBigEndian(const std::vector<uint8_t>& data, size_t offset, uint32_t numBytes)
+{
+  uint32_t val = 0;
+  for(uint32_t i = 0; i < numBytes; ++i)
+    val = (val << 8) | data[offset + i];
+
+  return val;
+}
+
+/**
+ * Swaps tile indices of first two tile parts in sidecar file, so that the
+ * index no longer matches the code stream it identifies
+ */
+static bool swapIndexedTileParts(const char* sidecar)
+{
+  std::vector<uint8_t> data;
+  if(!readTestFile(sidecar, data))
+    return false;
+  // magic, version, source identity, number of tiles, main header, tile parts
+  size_t offset = 8;
+  if(data.size() < offset + 4)
+    return false;
+  offset += 4 + readBigEndian(data, offset, 4) + 2;
+  if(data.size() < offset + 4)
+    return false;
+  offset += 4 + readBigEndian(data, offset, 4);
+  const size_t tilePartLen = 18;
+  if(data.size() < offset + 4 + 2 * tilePartLen || readBigEndian(data, offset, 4) < 2)
+    return false;
+  offset += 4;
+  std::swap(data[offset], data[offset + tilePartLen]);
+  std::swap(data[offset + 1], data[offset + tilePartLen + 1]);
+
+  return writeTestFile(sidecar, data);
+}
+
+static bool decompressWithIndex(const char* file, const char* sidecar, const double* window,
+                                uint64_t* checksum)
+{
+  grk_decompress_parameters params = {};
+  params.core.index_file = sidecar;
+
+  return decompressChecksum(file, &params, window, checksum);
+}
+
+static bool decompressTileWithIndex(const char* file, const char* sidecar, uint16_t tileIndex,
+                                    uint64_t* checksum)
+{
+  grk_decompress_parameters params = {};
+  params.core.index_file = sidecar;
+  grk_stream_params streamParams = {};
+  streamParams.file = file;
+  auto codec = grk_decompress_init(&streamParams, &params);
+  if(!codec)
+    return false;
+  grk_header_info headerInfo = {};
+  bool rc = grk_decompress_read_header(codec, &headerInfo) && grk_decompress_tile(codec, tileIndex);
+  if(rc)
+  {
+    auto image = grk_decompress_get_tile_image(codec, tileIndex, true);
+    *checksum = image ? imageChecksum(image) : 0;
+    rc = *checksum != 0;
+    if(image)
+      grk_object_unref(&image->obj);
+  }
+  grk_object_unref(codec);
+
+  return rc;
+}
+
+static bool runTest(void)
+{
+  auto file = testFilePath("grk_index_test.j2k");
+  auto sidecar = file + ".gidx";
+  auto otherFile = testFilePath("grk_index_test_other.j2k");
+  auto otherSidecar = otherFile + ".gidx";
+  remove(sidecar.c_str());
+  remove(otherSidecar.c_str());
+
+  TestImageParams imageParams;
+  if(!check(compressTestImage(file.c_str(), imageParams), "compress test image"))
+    return false;
+  imageParams.width = 384;
+  imageParams.tileDim = 64;
+  if(!check(compressTestImage(otherFile.c_str(), imageParams), "compress other test image"))
+    return false;
+
+  // reference decompressions without index
+  grk_decompress_parameters params = {};
+  uint64_t refFull = 0, refWindow = 0, refTile = 0, checksum = 0;
+  if(!check(decompressChecksum(file.c_str(), &params, nullptr, &refFull), "decompress image") ||
+     !check(decompressChecksum(file.c_str(), &params, testWindow, &refWindow),
+            "decompress window") ||
+     !check(decompressTileWithIndex(file.c_str(), nullptr, 5, &refTile), "decompress tile"))
+    return false;
+
+  // build index with a full decompress
+  if(!check(decompressWithIndex(file.c_str(), sidecar.c_str(), nullptr, &checksum) &&
+                checksum == refFull,
+            "decompress image while building index"))
+    return false;
+  std::vector<uint8_t> sidecarData;
+  if(!check(readTestFile(sidecar.c_str(), sidecarData) && !sidecarData.empty(), "index written"))
+    return false;
+
+  // reopen with index
+  if(!check(decompressWithIndex(file.c_str(), sidecar.c_str(), testWindow, &checksum) &&
+                checksum == refWindow,
+            "decompress window with index") ||
+     !check(decompressTileWithIndex(file.c_str(), sidecar.c_str(), 5, &checksum) &&
+                checksum == refTile,
+            "decompress tile with index"))
+    return false;
+
+  // tampered index : tile parts no longer match code stream, so index must be dropped
+  if(!check(swapIndexedTileParts(sidecar.c_str()), "tamper with index") ||
+     !check(decompressWithIndex(file.c_str(), sidecar.c_str(), testWindow, &checksum) &&
+                checksum == refWindow,
+            "decompress window with tampered index") ||
+     !check(decompressTileWithIndex(file.c_str(), sidecar.c_str(), 0, &checksum),
+            "decompress tile with tampered index"))
+    return false;
+
+  // index of another code stream is rejected, and rebuilt by a full decompress
+  if(!check(decompressWithIndex(otherFile.c_str(), otherSidecar.c_str(), nullptr, &checksum),
+            "build index of other image") ||
+     !check(decompressWithIndex(file.c_str(), otherSidecar.c_str(), testWindow, &checksum) &&
+                checksum == refWindow,
+            "decompress window with mismatched index") ||
+     !check(decompressWithIndex(file.c_str(), otherSidecar.c_str(), nullptr, &checksum) &&
+                checksum == refFull,
+            "decompress image with mismatched index"))
+    return false;
+  std::vector<uint8_t> rebuiltData;
+  if(!check(readTestFile(otherSidecar.c_str(), rebuiltData) && rebuiltData == sidecarData,
+            "mismatched index rebuilt"))
+    return false;
+
+  // truncated index is ignored
+  sidecarData.resize(sidecarData.size() / 2);
+  if(!check(writeTestFile(sidecar.c_str(), sidecarData), "truncate index") ||
+     !check(decompressWithIndex(file.c_str(), sidecar.c_str(), testWindow, &checksum) &&
+                checksum == refWindow,
+            "decompress window with truncated index"))
+    return false;
+
+  remove(file.c_str());
+  remove(sidecar.c_str());
+  remove(otherFile.c_str());
+  remove(otherSidecar.c_str());
+
+  return true;
+}
+
+int GrkCodeStreamIndexTest::main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+{
+  grk_initialize(nullptr, 0);
+  bool rc = runTest();
+  grk_deinitialize();
+
+  return rc ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace grk
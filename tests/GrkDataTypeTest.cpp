@@ -0,0 +1,134 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "grok.h"
+#include "GrkTestCodeStream.h"
+#include "GrkDataTypeTest.h"
+
+namespace grk
+{
+
+/**
+ * Decompresses test image with given output data type, and checks the samples
+ * of the decompressed image
+ *
+ * @param file        test code stream
+ * @param imageParams test image parameters
+ * @param dataType    output data type
+ * @param window      decompress window x0,y0,x1,y1, or nullptr for the whole image
+ * @return true if decompressed image holds expected samples of the output data type
+ */
+static bool decompressDataType(const char* file, const TestImageParams& imageParams,
+                               GRK_DATA_TYPE dataType, const double* window)
+{
+  grk_decompress_parameters params = {};
+  params.core.output_data_type = dataType;
+  grk_stream_params streamParams = {};
+  streamParams.file = file;
+  auto codec = grk_decompress_init(&streamParams, &params);
+  if(!codec)
+    return false;
+  grk_header_info headerInfo = {};
+  bool rc = grk_decompress_read_header(codec, &headerInfo);
+  if(rc && window)
+    rc = grk_decompress_set_window(codec, window[0], window[1], window[2], window[3]);
+  rc = rc && grk_decompress(codec, nullptr);
+  auto image = rc ? grk_decompress_get_image(codec) : nullptr;
+  rc = image && image->numcomps == imageParams.numComps;
+  uint64_t size = sampleSize(dataType);
+  for(uint16_t compno = 0; rc && compno < image->numcomps; ++compno)
+  {
+    auto comp = image->comps + compno;
+    rc = comp->data && comp->data_type == dataType;
+    for(uint32_t y = 0; rc && y < comp->h; ++y)
+    {
+      for(uint32_t x = 0; rc && x < comp->w; ++x)
+      {
+        auto ptr = (const uint8_t*)comp->data + ((uint64_t)y * comp->stride + x) * size;
+        rc = readSample(ptr, dataType) ==
+             testSample(imageParams, compno, comp->x0 + x, comp->y0 + y, dataType);
+      }
+    }
+  }
+  grk_object_unref(codec);
+
+  return rc;
+}
+
+/**
+ * Compresses test image, and decompresses it to each output data type
+ */
+static bool testDataTypes(const TestImageParams& imageParams, const char* msg)
+{
+  auto file = testFilePath("grk_data_type_test.j2k");
+  if(!check(compressTestImage(file.c_str(), imageParams), msg))
+    return false;
+  const double window[4] = {30, 20, 200, 150};
+  bool rc = true;
+  for(auto dataType : {GRK_UINT_8, GRK_UINT_16, GRK_FLOAT})
+  {
+    rc = rc && check(decompressDataType(file.c_str(), imageParams, dataType, nullptr), msg) &&
+         check(decompressDataType(file.c_str(), imageParams, dataType, window), msg);
+  }
+  remove(file.c_str());
+
+  return rc;
+}
+
+static bool runTest(void)
+{
+  TestImageParams imageParams;
+  imageParams.width = 256;
+  imageParams.height = 256;
+
+  // multiple tiles are composited into components of the output data type
+  imageParams.tileDim = 64;
+  bool rc = testDataTypes(imageParams, "multiple tiles");
+
+  // inverse MCT of a single tile writes the output data type
+  imageParams.tileDim = 0;
+  rc = rc && testDataTypes(imageParams, "single tile with MCT");
+
+  // inverse DC shift of a single tile writes the output data type, and
+  // signed samples are offset into unsigned output data types
+  imageParams.numComps = 1;
+  imageParams.sgnd = true;
+  rc = rc && testDataTypes(imageParams, "signed single tile");
+
+  // 12 bit samples are clamped to 8 bit output
+  imageParams.prec = 12;
+  rc = rc && testDataTypes(imageParams, "signed 12 bit single tile");
+  imageParams.numComps = 3;
+  imageParams.sgnd = false;
+  imageParams.tileDim = 64;
+  rc = rc && testDataTypes(imageParams, "12 bit multiple tiles");
+
+  return rc;
+}
+
+int GrkDataTypeTest::main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+{
+  grk_initialize(nullptr, 0);
+  bool rc = runTest();
+  grk_deinitialize();
+
+  return rc ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace grk
@@ -0,0 +1,152 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "grok.h"
+#include "GrkTestCodeStream.h"
+#include "GrkDecompressBufferTest.h"
+
+namespace grk
+{
+
+/**
+ * Decompresses test image into caller owned buffer, and checks the buffer's samples
+ *
+ * @param file        test code stream
+ * @param imageParams test image parameters
+ * @param buffer      buffer layout : data and len are allocated here.
+ * If stride is zero, then rows are packed
+ * @param padding     bytes of padding at the end of each row and plane
+ * @param window      decompress window x0,y0,x1,y1, or nullptr for the whole image
+ * @param expectValid true if buffer layout is valid
+ * @return true if decompression succeeded and buffer holds expected samples,
+ * or if decompression into invalid layout failed
+ */
+static bool decompressToBuffer(const char* file, const TestImageParams& imageParams,
+                               grk_decompress_buffer buffer, uint64_t padding,
+                               const double* window, bool expectValid)
+{
+  grk_decompress_parameters params = {};
+  grk_stream_params streamParams = {};
+  streamParams.file = file;
+  auto codec = grk_decompress_init(&streamParams, &params);
+  if(!codec)
+    return false;
+  grk_header_info headerInfo = {};
+  bool rc = grk_decompress_read_header(codec, &headerInfo);
+  if(rc && window)
+    rc = grk_decompress_set_window(codec, window[0], window[1], window[2], window[3]);
+  auto image = grk_decompress_get_image(codec);
+  rc = rc && image;
+  if(!rc)
+  {
+    grk_object_unref(codec);
+    return false;
+  }
+  auto comp = image->comps;
+  uint64_t size = sampleSize(buffer.data_type);
+  uint64_t rowBytes = comp->w * size * (buffer.interleaved ? image->numcomps : 1);
+  if(!buffer.stride)
+    buffer.stride = rowBytes + padding;
+  uint64_t planeBytes = buffer.stride * comp->h;
+  if(!buffer.interleaved && !buffer.plane_stride)
+    buffer.plane_stride = planeBytes + padding;
+  buffer.len = buffer.interleaved ? planeBytes
+                                  : buffer.plane_stride * (image->numcomps - 1U) + planeBytes;
+  std::vector<uint8_t> data(buffer.len);
+  buffer.data = data.data();
+  rc = grk_decompress_set_buffer(codec, &buffer) && grk_decompress(codec, nullptr);
+  if(!expectValid)
+  {
+    grk_object_unref(codec);
+    return !rc;
+  }
+  if(rc)
+  {
+    for(uint16_t compno = 0; rc && compno < image->numcomps; ++compno)
+    {
+      comp = image->comps + compno;
+      rc = !comp->data;
+      for(uint32_t y = 0; rc && y < comp->h; ++y)
+      {
+        for(uint32_t x = 0; rc && x < comp->w; ++x)
+        {
+          auto ptr = buffer.data + y * buffer.stride +
+                     (buffer.interleaved ? ((uint64_t)x * image->numcomps + compno) * size
+                                         : compno * buffer.plane_stride + x * size);
+          rc = readSample(ptr, buffer.data_type) ==
+               testSample(imageParams, compno, comp->x0 + x, comp->y0 + y);
+        }
+      }
+    }
+  }
+  grk_object_unref(codec);
+
+  return rc;
+}
+
+static bool runTest(void)
+{
+  auto file = testFilePath("grk_decompress_buffer_test.j2k");
+  TestImageParams imageParams;
+  if(!check(compressTestImage(file.c_str(), imageParams), "compress test image"))
+    return false;
+  const double window[4] = {100, 60, 300, 260};
+
+  grk_decompress_buffer planar = {};
+  planar.data_type = GRK_INT_32;
+  grk_decompress_buffer interleaved = {};
+  interleaved.data_type = GRK_UINT_8;
+  interleaved.interleaved = true;
+  bool rc =
+      check(decompressToBuffer(file.c_str(), imageParams, planar, 0, nullptr, true),
+            "planar") &&
+      check(decompressToBuffer(file.c_str(), imageParams, planar, 96, window, true),
+            "padded planar window") &&
+      check(decompressToBuffer(file.c_str(), imageParams, interleaved, 0, nullptr, true),
+            "interleaved") &&
+      check(decompressToBuffer(file.c_str(), imageParams, interleaved, 40, window, true),
+            "padded interleaved window");
+
+  // overlapping planes
+  planar.stride = imageParams.width * sizeof(int32_t);
+  planar.plane_stride = planar.stride * (imageParams.height - 1);
+  rc = rc && check(decompressToBuffer(file.c_str(), imageParams, planar, 0, nullptr, false),
+                   "reject overlapping planes");
+
+  // stride that only holds the first component of each row
+  interleaved.stride = imageParams.width;
+  rc = rc && check(decompressToBuffer(file.c_str(), imageParams, interleaved, 0, nullptr, false),
+                   "reject short interleaved stride");
+  remove(file.c_str());
+
+  return rc;
+}
+
+int GrkDecompressBufferTest::main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+{
+  grk_initialize(nullptr, 0);
+  bool rc = runTest();
+  grk_deinitialize();
+
+  return rc ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace grk
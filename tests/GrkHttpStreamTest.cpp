@@ -0,0 +1,277 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "grok.h"
+#include "GrkTestCodeStream.h"
+#include "GrkHttpStreamTest.h"
+
+namespace grk
+{
+
+static const double testWindow[4] = {600, 100, 800, 300};
+static const uint64_t httpBlockSize = 64 * 1024;
+
+/**
+ * Byte range requested from test server
+ */
+struct TestHttpRequest
+{
+  uint64_t first;
+  uint64_t last;
+};
+
+/**
+ * Minimal HTTP/1.1 server on the loopback interface, which serves a single code stream
+ * with byte range requests, and records the requested ranges
+ */
+class TestHttpServer
+{
+public:
+  TestHttpServer(const std::vector<uint8_t>& data, bool ignoreRanges)
+      : data_(data), ignoreRanges_(ignoreRanges), listenFd_(-1), port_(0)
+  {}
+  ~TestHttpServer()
+  {
+    if(listenFd_ >= 0)
+    {
+      // unblock accept
+      shutdown(listenFd_, SHUT_RDWR);
+      acceptThread_.join();
+      close(listenFd_);
+    }
+    for(auto fd : connectionFds_)
+      shutdown(fd, SHUT_RDWR);
+    for(auto& connection : connections_)
+      connection.join();
+    for(auto fd : connectionFds_)
+      close(fd);
+  }
+  bool start(void)
+  {
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if(listenFd_ < 0)
+      return false;
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addrLen = sizeof(addr);
+    if(bind(listenFd_, (sockaddr*)&addr, sizeof(addr)) != 0 ||
+       getsockname(listenFd_, (sockaddr*)&addr, &addrLen) != 0 || listen(listenFd_, 16) != 0)
+    {
+      close(listenFd_);
+      listenFd_ = -1;
+      return false;
+    }
+    port_ = ntohs(addr.sin_port);
+    acceptThread_ = std::thread([this] { serve(); });
+
+    return true;
+  }
+  std::string url(void) const
+  {
+    return "http://127.0.0.1:" + std::to_string(port_) + "/test.j2k";
+  }
+  std::vector<TestHttpRequest> takeRequests(void)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<TestHttpRequest> rc;
+    rc.swap(requests_);
+
+    return rc;
+  }
+
+private:
+  void serve(void)
+  {
+    while(true)
+    {
+      int fd = accept(listenFd_, nullptr, nullptr);
+      if(fd < 0)
+        break;
+      std::lock_guard<std::mutex> lock(mutex_);
+      connectionFds_.push_back(fd);
+      connections_.emplace_back([this, fd] { serveConnection(fd); });
+    }
+  }
+  bool sendAll(int fd, const uint8_t* buf, size_t len)
+  {
+    while(len)
+    {
+      auto count = send(fd, buf, len, MSG_NOSIGNAL);
+      if(count <= 0)
+        return false;
+      buf += count;
+      len -= (size_t)count;
+    }
+
+    return true;
+  }
+  // serves requests of one keep-alive connection
+  void serveConnection(int fd)
+  {
+    std::string pending;
+    char buf[4096];
+    while(true)
+    {
+      auto headerEnd = pending.find("\r\n\r\n");
+      if(headerEnd == std::string::npos)
+      {
+        auto count = recv(fd, buf, sizeof(buf), 0);
+        if(count <= 0)
+          break;
+        pending.append(buf, (size_t)count);
+        continue;
+      }
+      auto header = pending.substr(0, headerEnd);
+      pending.erase(0, headerEnd + 4);
+      uint64_t first = 0;
+      uint64_t last = data_.size() - 1;
+      auto rangePos = header.find("\r\nRange: bytes=");
+      bool ranged = rangePos != std::string::npos && !ignoreRanges_;
+      if(ranged)
+      {
+        if(sscanf(header.c_str() + rangePos + 15, "%" SCNu64 "-%" SCNu64, &first, &last) != 2 ||
+           first > last || first >= data_.size())
+          break;
+        last = std::min<uint64_t>(last, data_.size() - 1);
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.push_back({first, last});
+      }
+      std::string response = ranged ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n";
+      if(ranged)
+        response += "Content-Range: bytes " + std::to_string(first) + "-" +
+                    std::to_string(last) + "/" + std::to_string(data_.size()) + "\r\n";
+      response += "Content-Length: " + std::to_string(last - first + 1) + "\r\n\r\n";
+      if(!sendAll(fd, (const uint8_t*)response.data(), response.size()) ||
+         !sendAll(fd, data_.data() + first, (size_t)(last - first + 1)))
+        break;
+    }
+  }
+
+  const std::vector<uint8_t>& data_;
+  bool ignoreRanges_;
+  int listenFd_;
+  uint16_t port_;
+  std::thread acceptThread_;
+  std::mutex mutex_;
+  std::vector<std::thread> connections_;
+  std::vector<int> connectionFds_;
+  std::vector<TestHttpRequest> requests_;
+};
+
+static bool runTest(void)
+{
+  auto file = testFilePath("grk_http_stream_test.j2k");
+  TestImageParams imageParams;
+  imageParams.width = 1024;
+  imageParams.height = 1024;
+  std::vector<uint8_t> data;
+  if(!check(compressTestImage(file.c_str(), imageParams), "compress test image") ||
+     !check(readTestFile(file.c_str(), data), "read test image"))
+    return false;
+  remove(file.c_str());
+  uint64_t numBlocks = (data.size() + httpBlockSize - 1) / httpBlockSize;
+  if(!check(numBlocks > 4, "test image spans several blocks"))
+    return false;
+
+  // reference decompressions from memory
+  grk_decompress_parameters params = {};
+  grk_stream_params memParams = {};
+  memParams.buf = data.data();
+  memParams.buf_len = data.size();
+  uint64_t refFull = 0, refWindow = 0, checksum = 0;
+  if(!check(decompressChecksum(&memParams, &params, nullptr, &refFull), "decompress image") ||
+     !check(decompressChecksum(&memParams, &params, testWindow, &refWindow),
+            "decompress window"))
+    return false;
+
+  TestHttpServer server(data, false);
+  if(!check(server.start(), "start server"))
+    return false;
+  auto url = server.url();
+  grk_stream_params httpParams = {};
+  httpParams.file = url.c_str();
+
+  // each block is fetched once, and runs of missing blocks are fetched with one request
+  if(!check(decompressChecksum(&httpParams, &params, nullptr, &checksum) && checksum == refFull,
+            "decompress image over HTTP"))
+    return false;
+  auto requests = server.takeRequests();
+  uint64_t requestedBytes = 0;
+  bool aligned = true;
+  for(auto& request : requests)
+  {
+    requestedBytes += request.last - request.first + 1;
+    aligned = aligned && (request.first % httpBlockSize) == 0 &&
+              ((request.last + 1) % httpBlockSize == 0 || request.last + 1 == data.size());
+  }
+  if(!check(aligned, "requests cover whole blocks") ||
+     !check(requestedBytes == data.size(), "each block fetched once") ||
+     !check(requests.size() < numBlocks, "runs of blocks fetched with single requests"))
+    return false;
+
+  // windowed decompression fetches part of the code stream
+  if(!check(decompressChecksum(&httpParams, &params, testWindow, &checksum) &&
+                checksum == refWindow,
+            "decompress window over HTTP"))
+    return false;
+  requests = server.takeRequests();
+  requestedBytes = 0;
+  for(auto& request : requests)
+    requestedBytes += request.last - request.first + 1;
+  if(!check(requestedBytes < data.size(), "window fetches part of code stream"))
+    return false;
+
+  // server that ignores ranges would send the whole code stream with each request
+  TestHttpServer fullServer(data, true);
+  if(!check(fullServer.start(), "start server without range support"))
+    return false;
+  url = fullServer.url();
+  httpParams.file = url.c_str();
+  auto codec = grk_decompress_init(&httpParams, &params);
+  if(codec)
+    grk_object_unref(codec);
+
+  return check(!codec, "reject server without range support");
+}
+
+int GrkHttpStreamTest::main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+{
+  // loopback requests must not go through a proxy
+  setenv("no_proxy", "127.0.0.1", 1);
+  // a single thread reads the code stream sequentially, so requests are deterministic
+  grk_initialize(nullptr, 1);
+  bool rc = runTest();
+  grk_deinitialize();
+
+  return rc ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace grk
@@ -0,0 +1,111 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "grok.h"
+#include "GrkTestCodeStream.h"
+#include "GrkMappedFileTest.h"
+
+namespace grk
+{
+
+static const double testWindow[4] = {100, 100, 300, 260};
+
+/**
+ * Decompresses file with memory mapping, or with the C file api
+ */
+static bool decompressFile(const char* file, bool useStdio, const double* window,
+                           uint64_t* checksum)
+{
+  grk_decompress_parameters params = {};
+  grk_stream_params streamParams = {};
+  streamParams.file = file;
+  streamParams.use_stdio = useStdio;
+
+  return decompressChecksum(&streamParams, &params, window, checksum);
+}
+
+static bool runTest(void)
+{
+  auto file = testFilePath("grk_mapped_file_test.j2k");
+  auto truncatedFile = testFilePath("grk_mapped_file_test_truncated.j2k");
+  TestImageParams imageParams;
+  std::vector<uint8_t> data;
+  if(!check(compressTestImage(file.c_str(), imageParams), "compress test image") ||
+     !check(readTestFile(file.c_str(), data), "read test image"))
+    return false;
+
+  // reference decompressions from memory
+  grk_decompress_parameters params = {};
+  grk_stream_params memParams = {};
+  memParams.buf = data.data();
+  memParams.buf_len = data.size();
+  uint64_t refFull = 0, refWindow = 0, checksum = 0;
+  if(!check(decompressChecksum(&memParams, &params, nullptr, &refFull), "decompress image") ||
+     !check(decompressChecksum(&memParams, &params, testWindow, &refWindow),
+            "decompress window"))
+    return false;
+
+  bool rc = check(decompressFile(file.c_str(), false, nullptr, &checksum) && checksum == refFull,
+                  "decompress mapped image") &&
+            check(decompressFile(file.c_str(), false, testWindow, &checksum) &&
+                      checksum == refWindow,
+                  "decompress mapped window") &&
+            check(decompressFile(file.c_str(), true, nullptr, &checksum) && checksum == refFull,
+                  "decompress image with C file api");
+
+  // empty file can't be mapped, and has no code stream
+  rc = rc && check(writeTestFile(truncatedFile.c_str(), {}), "write empty file") &&
+       check(!decompressFile(truncatedFile.c_str(), false, nullptr, &checksum),
+             "reject empty file");
+
+  // truncated code streams : mapped decompression must behave as the C file api does
+  const size_t truncatedLengths[] = {11, 200, data.size() / 2, data.size() - 2};
+  for(auto len : truncatedLengths)
+  {
+    if(!rc)
+      break;
+    std::vector<uint8_t> truncated(data.begin(), data.begin() + (std::ptrdiff_t)len);
+    uint64_t mappedChecksum = 0, stdioChecksum = 0;
+    rc = check(writeTestFile(truncatedFile.c_str(), truncated), "write truncated file");
+    if(rc)
+    {
+      bool mapped = decompressFile(truncatedFile.c_str(), false, nullptr, &mappedChecksum);
+      bool stdio = decompressFile(truncatedFile.c_str(), true, nullptr, &stdioChecksum);
+      rc = check(mapped == stdio && mappedChecksum == stdioChecksum,
+                 "truncated file decompresses as with C file api");
+    }
+  }
+  remove(file.c_str());
+  remove(truncatedFile.c_str());
+
+  return rc;
+}
+
+int GrkMappedFileTest::main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+{
+  grk_initialize(nullptr, 0);
+  bool rc = runTest();
+  grk_deinitialize();
+
+  return rc ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace grk
@@ -0,0 +1,104 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "grok.h"
+#include "GrkTestCodeStream.h"
+#include "GrkMemoryBudgetTest.h"
+
+namespace grk
+{
+
+/**
+ * Decompresses file with memory budget, and checksums the decompressed image
+ */
+static bool decompressBudget(const char* path, uint64_t budget, uint64_t* checksum,
+                             grk_memory_stats* stats)
+{
+  grk_decompress_parameters params = {};
+  params.core.memory_budget = budget;
+  grk_stream_params streamParams = {};
+  streamParams.file = path;
+  auto codec = grk_decompress_init(&streamParams, &params);
+  if(!check(codec != nullptr, "create decompressor"))
+    return false;
+  grk_header_info headerInfo = {};
+  bool rc = check(grk_decompress_read_header(codec, &headerInfo), "read header") &&
+            check(grk_decompress(codec, nullptr), "decompress image");
+  if(rc)
+  {
+    *checksum = imageChecksum(grk_decompress_get_image(codec));
+    rc = check(*checksum != 0, "checksum image") &&
+         check(grk_get_memory_stats(codec, stats), "get memory stats");
+  }
+  grk_object_unref(codec);
+
+  return rc;
+}
+
+/**
+ * Peak bytes held in categories that count against the budget
+ */
+static uint64_t budgetedPeak(const grk_memory_stats& stats)
+{
+  return stats.peak[GRK_MEM_TILE_WINDOW] + stats.peak[GRK_MEM_COMPOSITE] +
+         stats.peak[GRK_MEM_T1] + stats.peak[GRK_MEM_CACHE];
+}
+
+static bool runTest(void)
+{
+  auto file = testFilePath("grk_memory_budget_test.j2k");
+  TestImageParams imageParams;
+  imageParams.tileDim = 64;
+  if(!check(compressTestImage(file.c_str(), imageParams), "compress test image"))
+    return false;
+
+  // unbounded decompression measures composite image and tile footprint
+  uint64_t refChecksum = 0;
+  grk_memory_stats refStats = {};
+  bool rc = decompressBudget(file.c_str(), 0, &refChecksum, &refStats) &&
+            check(refStats.budget == 0 && refStats.admission_waits == 0 &&
+                      refStats.tile_footprint != 0 && refStats.peak[GRK_MEM_COMPOSITE] != 0,
+                  "stats without budget");
+
+  // budget leaves room for two tiles in flight besides the composite image
+  uint64_t budget = refStats.peak[GRK_MEM_COMPOSITE] + 2 * refStats.tile_footprint;
+  uint64_t checksum = 0;
+  grk_memory_stats stats = {};
+  rc = rc && decompressBudget(file.c_str(), budget, &checksum, &stats) &&
+       check(checksum == refChecksum, "checksum with budget") &&
+       check(stats.budget == budget, "budget in stats") &&
+       check(stats.admission_waits != 0, "tiles waited for admission") &&
+       check(budgetedPeak(stats) <= budget, "peak bytes within budget");
+  remove(file.c_str());
+
+  return rc;
+}
+
+int GrkMemoryBudgetTest::main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+{
+  // more workers than the budget admits tiles in flight
+  grk_initialize(nullptr, 4);
+  bool rc = runTest();
+  grk_deinitialize();
+
+  return rc ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace grk
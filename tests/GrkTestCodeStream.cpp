@@ -0,0 +1,219 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include "GrkTestCodeStream.h"
+
+namespace grk
+{
+
+bool check(bool condition, const char* msg)
+{
+  if(!condition)
+    fprintf(stderr, "test failed: %s\n", msg);
+
+  return condition;
+}
+
+std::string testFilePath(const char* name)
+{
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+int32_t testSample(const TestImageParams& params, uint16_t compno, uint32_t x, uint32_t y)
+{
+  uint32_t range = 1U << params.prec;
+  auto val = (int32_t)((((x * 7 + y * 3 + compno * 50) ^ (x * y)) + (x >> 4) * 13) % range);
+  if(params.sgnd)
+    val -= (int32_t)(range >> 1);
+
+  return val;
+}
+
+int32_t testSample(const TestImageParams& params, uint16_t compno, uint32_t x, uint32_t y,
+                   GRK_DATA_TYPE dataType)
+{
+  auto val = testSample(params, compno, x, y);
+  int32_t maxVal;
+  switch(dataType)
+  {
+    case GRK_UINT_8:
+      maxVal = 0xFF;
+      break;
+    case GRK_UINT_16:
+      maxVal = 0xFFFF;
+      break;
+    default:
+      return val;
+  }
+  if(params.sgnd)
+    val += (int32_t)(1U << (params.prec - 1));
+
+  return std::clamp(val, 0, maxVal);
+}
+
+bool compressTestImage(const char* path, const TestImageParams& params)
+{
+  grk_cparameters cparams;
+  grk_compress_set_default_params(&cparams);
+  cparams.cod_format = GRK_FMT_J2K;
+  if(params.tileDim)
+  {
+    cparams.tile_size_on = true;
+    cparams.t_width = params.tileDim;
+    cparams.t_height = params.tileDim;
+  }
+  cparams.write_plt = params.writePLT;
+
+  std::vector<grk_image_comp> comps(params.numComps);
+  memset(comps.data(), 0, comps.size() * sizeof(grk_image_comp));
+  for(auto& comp : comps)
+  {
+    comp.w = params.width;
+    comp.h = params.height;
+    comp.dx = 1;
+    comp.dy = 1;
+    comp.prec = params.prec;
+    comp.sgnd = params.sgnd;
+  }
+  auto image = grk_image_new(params.numComps, comps.data(),
+                             params.numComps == 3 ? GRK_CLRSPC_SRGB : GRK_CLRSPC_GRAY, true);
+  if(!image)
+    return false;
+  for(uint16_t compno = 0; compno < image->numcomps; ++compno)
+  {
+    auto comp = image->comps + compno;
+    auto data = (int32_t*)comp->data;
+    for(uint32_t y = 0; y < comp->h; ++y)
+      for(uint32_t x = 0; x < comp->w; ++x)
+        data[(size_t)y * comp->stride + x] = testSample(params, compno, x, y);
+  }
+  grk_stream_params streamParams = {};
+  streamParams.file = path;
+  auto codec = grk_compress_init(&streamParams, &cparams, image);
+  bool rc = codec && grk_compress(codec, nullptr) != 0;
+  if(codec)
+    grk_object_unref(codec);
+  grk_object_unref(&image->obj);
+
+  return rc;
+}
+
+uint64_t sampleSize(GRK_DATA_TYPE dataType)
+{
+  switch(dataType)
+  {
+    case GRK_UINT_8:
+      return 1;
+    case GRK_UINT_16:
+      return 2;
+    default:
+      return 4;
+  }
+}
+
+int32_t readSample(const uint8_t* ptr, GRK_DATA_TYPE dataType)
+{
+  switch(dataType)
+  {
+    case GRK_UINT_8:
+      return *ptr;
+    case GRK_UINT_16:
+      return *(const uint16_t*)ptr;
+    case GRK_FLOAT:
+      return (int32_t)*(const float*)ptr;
+    default:
+      return *(const int32_t*)ptr;
+  }
+}
+
+bool readTestFile(const char* path, std::vector<uint8_t>& data)
+{
+  auto fp = fopen(path, "rb");
+  if(!fp)
+    return false;
+  data.clear();
+  uint8_t chunk[65536];
+  size_t bytesRead;
+  while((bytesRead = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+    data.insert(data.end(), chunk, chunk + bytesRead);
+  fclose(fp);
+
+  return true;
+}
+
+bool writeTestFile(const char* path, const std::vector<uint8_t>& data)
+{
+  auto fp = fopen(path, "wb");
+  if(!fp)
+    return false;
+  bool rc = fwrite(data.data(), 1, data.size(), fp) == data.size();
+
+  return (fclose(fp) == 0) && rc;
+}
+
+uint64_t imageChecksum(const grk_image* image)
+{
+  uint64_t sum = 1469598103934665603ULL;
+  for(uint16_t compno = 0; compno < image->numcomps; ++compno)
+  {
+    auto comp = image->comps + compno;
+    auto data = (const int32_t*)comp->data;
+    if(!data)
+      return 0;
+    for(uint32_t y = 0; y < comp->h; ++y)
+      for(uint32_t x = 0; x < comp->w; ++x)
+        sum = (sum ^ (uint32_t)data[(size_t)y * comp->stride + x]) * 1099511628211ULL;
+  }
+
+  return sum;
+}
+
+bool decompressChecksum(grk_stream_params* streamParams, grk_decompress_parameters* params,
+                        const double* window, uint64_t* checksum)
+{
+  auto codec = grk_decompress_init(streamParams, params);
+  if(!codec)
+    return false;
+  grk_header_info headerInfo = {};
+  bool rc = grk_decompress_read_header(codec, &headerInfo);
+  if(rc && window)
+    rc = grk_decompress_set_window(codec, window[0], window[1], window[2], window[3]);
+  rc = rc && grk_decompress(codec, nullptr);
+  if(rc)
+  {
+    *checksum = imageChecksum(grk_decompress_get_image(codec));
+    rc = *checksum != 0;
+  }
+  grk_object_unref(codec);
+
+  return rc;
+}
+
+bool decompressChecksum(const char* path, grk_decompress_parameters* params,
+                        const double* window, uint64_t* checksum)
+{
+  grk_stream_params streamParams = {};
+  streamParams.file = path;
+
+  return decompressChecksum(&streamParams, params, window, checksum);
+}
+
+} // namespace grk
@@ -0,0 +1,122 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "grok.h"
+
+namespace grk
+{
+
+/**
+ * Synthetic test image
+ */
+struct TestImageParams
+{
+  TestImageParams(void)
+      : width(512), height(512), numComps(3), tileDim(128), prec(8), sgnd(false), writePLT(false)
+  {}
+  uint32_t width;
+  uint32_t height;
+  uint16_t numComps;
+  // tile width and height, or zero for a single tile
+  uint32_t tileDim;
+  uint8_t prec;
+  bool sgnd;
+  bool writePLT;
+};
+
+/**
+ * Reports failed test condition
+ *
+ * @param condition test condition
+ * @param msg description of condition
+ * @return condition
+ */
+bool check(bool condition, const char* msg);
+
+/**
+ * Gets path of file in temporary directory
+ */
+std::string testFilePath(const char* name);
+
+/**
+ * Gets sample value of synthetic test image
+ */
+int32_t testSample(const TestImageParams& params, uint16_t compno, uint32_t x, uint32_t y);
+
+/**
+ * Gets sample value of synthetic test image, converted to given data type : signed samples
+ * are offset into the range of unsigned types, and then clamped to the range of the type
+ */
+int32_t testSample(const TestImageParams& params, uint16_t compno, uint32_t x, uint32_t y,
+                   GRK_DATA_TYPE dataType);
+
+/**
+ * Compresses synthetic test image, losslessly, to a J2K file
+ *
+ * @return true if successful
+ */
+bool compressTestImage(const char* path, const TestImageParams& params);
+
+/**
+ * Gets size in bytes of sample of given data type
+ */
+uint64_t sampleSize(GRK_DATA_TYPE dataType);
+
+/**
+ * Reads sample of given data type, as a 32 bit integer
+ */
+int32_t readSample(const uint8_t* ptr, GRK_DATA_TYPE dataType);
+
+/**
+ * Reads whole file
+ */
+bool readTestFile(const char* path, std::vector<uint8_t>& data);
+
+/**
+ * Writes whole file
+ */
+bool writeTestFile(const char* path, const std::vector<uint8_t>& data);
+
+/**
+ * Checksums samples of decompressed image
+ */
+uint64_t imageChecksum(const grk_image* image);
+
+/**
+ * Decompresses code stream, and checksums the decompressed image
+ *
+ * @param streamParams stream parameters
+ * @param params decompress parameters
+ * @param window decompress window x0,y0,x1,y1, or nullptr for the whole image
+ * @param checksum checksum of decompressed image
+ * @return true if successful
+ */
+bool decompressChecksum(grk_stream_params* streamParams, grk_decompress_parameters* params,
+                        const double* window, uint64_t* checksum);
+
+/**
+ * Decompresses file, and checksums the decompressed image
+ */
+bool decompressChecksum(const char* path, grk_decompress_parameters* params,
+                        const double* window, uint64_t* checksum);
+
+} // namespace grk
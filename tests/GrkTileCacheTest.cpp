@@ -0,0 +1,140 @@
+/*
+ *    Copyright (C) 2016-2025 Grok Image Compression Inc.
+ *
+ *    This source code is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This source code is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "grok.h"
+#include "GrkTestCodeStream.h"
+#include "GrkTileCacheTest.h"
+
+namespace grk
+{
+
+/**
+ * Checks that tile image covers its tile, and holds the samples of the test image
+ */
+static bool checkTileImage(const TestImageParams& params, uint16_t tileIndex,
+                           const grk_image* image)
+{
+  uint32_t numTileCols = (params.width + params.tileDim - 1) / params.tileDim;
+  uint32_t x0 = (tileIndex % numTileCols) * params.tileDim;
+  uint32_t y0 = (tileIndex / numTileCols) * params.tileDim;
+  if(!image || image->x0 != x0 || image->y0 != y0 || image->x1 != x0 + params.tileDim ||
+     image->y1 != y0 + params.tileDim || image->numcomps != params.numComps)
+    return false;
+  for(uint16_t compno = 0; compno < image->numcomps; ++compno)
+  {
+    auto comp = image->comps + compno;
+    auto data = (const int32_t*)comp->data;
+    if(!data || comp->w != params.tileDim || comp->h != params.tileDim)
+      return false;
+    for(uint32_t y = 0; y < comp->h; ++y)
+      for(uint32_t x = 0; x < comp->w; ++x)
+        if(data[(size_t)y * comp->stride + x] != testSample(params, compno, x0 + x, y0 + y))
+          return false;
+  }
+
+  return true;
+}
+
+/**
+ * Retrieves tile image, checks it, and releases it
+ */
+static bool retrieveTile(grk_object* codec, const TestImageParams& params, uint16_t tileIndex)
+{
+  auto image = grk_decompress_get_tile_image(codec, tileIndex, true);
+  bool rc = checkTileImage(params, tileIndex, image);
+  if(image)
+    grk_object_unref(&image->obj);
+
+  return rc;
+}
+
+static bool runTest(void)
+{
+  auto file = testFilePath("grk_tile_cache_test.j2k");
+  TestImageParams imageParams;
+  if(!check(compressTestImage(file.c_str(), imageParams), "compress test image"))
+    return false;
+  const uint16_t numTiles = 16;
+  const uint32_t maxCachedTiles = 3;
+  uint64_t tileBytes =
+      (uint64_t)imageParams.tileDim * imageParams.tileDim * imageParams.numComps * sizeof(int32_t);
+
+  grk_decompress_parameters params = {};
+  params.core.tile_cache_strategy = GRK_TILE_CACHE_IMAGE;
+  params.core.tile_cache_max_bytes = maxCachedTiles * tileBytes + tileBytes / 2;
+  grk_stream_params streamParams = {};
+  streamParams.file = file.c_str();
+  auto codec = grk_decompress_init(&streamParams, &params);
+  if(!check(codec != nullptr, "create decompressor"))
+    return false;
+  grk_header_info headerInfo = {};
+  bool rc = check(grk_decompress_read_header(codec, &headerInfo), "read header") &&
+            check(grk_decompress(codec, nullptr), "decompress image");
+  grk_tile_cache_stats stats = {};
+  rc = rc && check(grk_decompress_get_tile_cache_stats(codec, &stats), "get stats") &&
+       check(stats.num_tiles == maxCachedTiles && stats.bytes == maxCachedTiles * tileBytes &&
+                 stats.evictions == numTiles - maxCachedTiles && stats.hits == 0 &&
+                 stats.misses == 0,
+             "stats after decompress");
+
+  // evicted tiles are decompressed again, and may then evict other tiles;
+  // a tile that was just retrieved is always cached
+  uint64_t evictions = stats.evictions;
+  for(uint16_t tileIndex = 0; rc && tileIndex < numTiles; ++tileIndex)
+  {
+    rc = check(retrieveTile(codec, imageParams, tileIndex), "retrieve tile") &&
+         check(retrieveTile(codec, imageParams, tileIndex), "retrieve tile again");
+  }
+  rc = rc && check(grk_decompress_get_tile_cache_stats(codec, &stats), "get stats") &&
+       check(stats.hits + stats.misses == 2 * numTiles && stats.hits >= numTiles &&
+                 stats.misses >= numTiles - maxCachedTiles &&
+                 stats.evictions == evictions + stats.misses &&
+                 stats.num_tiles == maxCachedTiles && stats.bytes == maxCachedTiles * tileBytes,
+             "stats after retrieving tiles");
+
+  // image held by client outlives eviction of its tile
+  grk_image* heldImage = nullptr;
+  if(rc)
+  {
+    heldImage = grk_decompress_get_tile_image(codec, 0, true);
+    for(uint16_t tileIndex = 1; rc && tileIndex < numTiles; ++tileIndex)
+      rc = check(retrieveTile(codec, imageParams, tileIndex), "retrieve other tile");
+    rc = rc && check(grk_decompress_get_tile_cache_stats(codec, &stats), "get stats") &&
+         check(stats.num_tiles == maxCachedTiles && stats.bytes == maxCachedTiles * tileBytes,
+               "stats after evicting held tile") &&
+         check(checkTileImage(imageParams, 0, heldImage), "held tile image");
+    if(heldImage)
+      grk_object_unref(&heldImage->obj);
+  }
+  grk_object_unref(codec);
+  remove(file.c_str());
+
+  return rc;
+}
+
+int GrkTileCacheTest::main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+{
+  grk_initialize(nullptr, 0);
+  bool rc = runTest();
+  grk_deinitialize();
+
+  return rc ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace grk